@@ -0,0 +1,34 @@
+#include "Arduino.h"
+#include <FlowMeterBank.h>  // https://github.com/sekdiy/FlowMeter
+
+// manage up to four flow sensors in one bank (no interrupt service routines to write)
+FlowMeterBank<4> Bank;
+
+// set the measurement update period to 1s (1000 ms)
+const unsigned long period = 1000;
+
+void setup() {
+    // prepare serial communication
+    Serial.begin(115200);
+
+    // connect the flow sensors to interrupt pins (see notes on your Arduino model for pin numbers)
+    Bank.attach(0, 2, UncalibratedSensor);
+    Bank.attach(1, 3, FS400A);
+}
+
+void loop() {
+    // wait between output updates
+    delay(period);
+
+    // update the flow measurement calculations of all channels at once
+    Bank.update(period);
+
+    // fetch and output some measurement results
+    for (uint8_t channel = 0; channel < 2; channel++) {
+        Serial.println("Channel " + String(channel) + " currently " + String(Bank.getCurrentFlowrate(channel)) + " l/min, " + String(Bank.getTotalVolume(channel)) + " l total.");
+    }
+
+    //
+    // any other code can go here
+    //
+}
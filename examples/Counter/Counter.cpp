@@ -0,0 +1,38 @@
+#include "Arduino.h"
+#include <FlowMeter.h>             // https://github.com/sekdiy/FlowMeter
+#include <FlowTimerPulseSource.h>
+
+// count the sensor's pulses in Timer1 instead of an interrupt service routine
+// (the sensor goes to the T1 pin: D5 on the Uno and Nano, D12 on the Leonardo)
+FlowTimerPulseSource Counter(RISING);
+FlowMeter *Meter;
+
+// set the measurement update period to 1s (1000 ms)
+const unsigned long period = 1000;
+
+void setup() {
+    // prepare serial communication
+    Serial.begin(115200);
+
+    // take over Timer1 (this has to happen in setup(), after the Arduino core has initialised the timers)
+    Counter.begin();
+
+    // get a new FlowMeter instance without an interrupt callback, and let it read the timer instead
+    Meter = new FlowMeter(5, FS400A);
+    Meter->setPulseSource(&Counter);
+}
+
+void loop() {
+    // wait between output updates
+    delay(period);
+
+    // process the pulses counted by the timer (at least once every 65535 pulses)
+    Meter->tick(period);
+
+    // output some measurement result
+    Serial.println("Currently " + String(Meter->getCurrentFlowrate()) + " l/min, " + String(Meter->getTotalVolume()) + " l total.");
+
+    //
+    // any other code can go here
+    //
+}
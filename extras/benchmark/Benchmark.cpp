@@ -0,0 +1,1068 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Host microbenchmark suite, reports the cost of the library's hot paths in ns/call.
+ * Build and run it with: pio run -e benchmark && .pio/build/benchmark/program
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "FixedFlowMeter.h"
+#include "CaptureFlowMeter.h"
+#include "FlowMeterBank.h"
+#include "FlowStatistics.h"
+#include "FlowTotalizer.h"
+#include "FlowFileStorage.h"
+#include "FlowSimulatedPulseSource.h"
+#include "FlowScheduler.h"
+#include "FlowAnomalyDetector.h"
+#include "FlowCalibrationFitter.h"
+#include "FlowTelemetry.h"
+#include "FlowTelemetryDecoder.h"
+#include "StaticFlowMeter.h"
+#include "Injected.h"
+
+static const unsigned int ticks = 4096;                                     // number of pre-generated ticks per distribution (power of two)
+static const unsigned long period = 1000;                                   // nominal tick duration (in ms)
+static const unsigned long repetitions = 200000;                            // timed calls per measurement
+
+static volatile double sink;                                                // keeps the optimiser from discarding results
+
+/**
+ * A named sensor preset, together with its compile-time specialised update benchmark.
+ */
+struct Preset {
+    const char *name;
+    FlowSensorProperties *properties;
+    double (*benchmarkStaticUpdate)(const unsigned long *pulses);
+};
+
+/**
+ * A named pulse distribution, relative to the full-scale pulse count of a tick.
+ */
+struct Distribution {
+    const char *name;
+    void (*generate)(std::minstd_rand &random, double fullScale, unsigned long *pulses);
+};
+
+static void idle(std::minstd_rand &random, double fullScale, unsigned long *pulses) {
+    (void) random;
+    (void) fullScale;
+    for (unsigned int i = 0; i < ticks; i++) pulses[i] = 0;
+}
+
+static void trickle(std::minstd_rand &random, double fullScale, unsigned long *pulses) {
+    std::poisson_distribution<unsigned long> flow(0.02 * fullScale + 0.5);  // a few pulses per tick near the bottom of the range
+    for (unsigned int i = 0; i < ticks; i++) pulses[i] = flow(random);
+}
+
+static void uniform(std::minstd_rand &random, double fullScale, unsigned long *pulses) {
+    std::uniform_int_distribution<unsigned long> flow(0, (unsigned long) fullScale);
+    for (unsigned int i = 0; i < ticks; i++) pulses[i] = flow(random);
+}
+
+static void capacity(std::minstd_rand &random, double fullScale, unsigned long *pulses) {
+    std::normal_distribution<double> flow(0.95 * fullScale, 0.02 * fullScale);
+    for (unsigned int i = 0; i < ticks; i++) pulses[i] = (unsigned long) max(0.0, flow(random));
+}
+
+static void bursty(std::minstd_rand &random, double fullScale, unsigned long *pulses) {
+    std::bernoulli_distribution open(0.1);                                 // valve open for one tick in ten
+    std::uniform_int_distribution<unsigned long> flow((unsigned long) (0.5 * fullScale), (unsigned long) fullScale);
+    for (unsigned int i = 0; i < ticks; i++) pulses[i] = open(random) ? flow(random) : 0;
+}
+
+static Distribution distributions[] = {
+    {"idle", idle},
+    {"trickle", trickle},
+    {"uniform", uniform},
+    {"capacity", capacity},
+    {"bursty", bursty},
+};
+
+template <class Body>
+static double measure(unsigned long calls, Body body) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    body();
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(stop - start).count() / calls;
+}
+
+template <class Meter>
+static double benchmarkUpdate(Meter &meter, const unsigned long *pulses) {
+    return measure(repetitions, [&]() {
+        for (unsigned long i = 0; i < repetitions; i++) {
+            meter.inject(pulses[i & (ticks - 1)]);
+            meter.update(period);
+        }
+        sink = meter.getTotalVolume();
+    });
+}
+
+static double benchmarkUpdate(FlowSensorProperties &properties, const unsigned long *pulses) {
+    Injected<FlowMeter> meter(2, properties);
+    return benchmarkUpdate(meter, pulses);
+}
+
+template <class Sensor>
+static double benchmarkStaticUpdate(const unsigned long *pulses) {
+    Injected<StaticFlowMeter<Sensor> > meter(2);
+    return benchmarkUpdate(meter, pulses);
+}
+
+static Preset presets[] = {
+    {"UncalibratedSensor", &UncalibratedSensor, benchmarkStaticUpdate<UncalibratedSensorTraits>},
+    {"FS300A", &FS300A, benchmarkStaticUpdate<FS300ATraits>},
+    {"FS400A", &FS400A, benchmarkStaticUpdate<FS400ATraits>},
+    {"FS400A_cal", &FS400A_cal, benchmarkStaticUpdate<FS400A_calTraits>},
+    {"FHKCS_1mm_0deg", &FHKCS_1mm_0deg, benchmarkStaticUpdate<FHKCS_1mm_0degTraits>},
+};
+
+static double benchmarkCurveUpdate(FlowSensorProperties &properties, const unsigned long *pulses) {
+    FlowCalibrationCurve curve(properties);
+    Injected<FlowMeter> meter(2, properties, curve);
+    return benchmarkUpdate(meter, pulses);
+}
+
+static double benchmarkCount(FlowSensorProperties &properties) {
+    FlowMeter meter(2, properties);
+
+    return measure(repetitions, [&]() {
+        for (unsigned long i = 0; i < repetitions; i++) {
+            meter.count();
+        }
+        meter.update(period);
+        sink = meter.getTotalVolume();
+    });
+}
+
+static double benchmarkTotalError(FlowSensorProperties &properties, const unsigned long *pulses) {
+    Injected<FlowMeter> meter(2, properties);
+
+    for (unsigned int i = 0; i < ticks; i++) {
+        meter.inject(pulses[i]);
+        meter.update(period);
+    }
+
+    return measure(repetitions, [&]() {
+        double error = 0.0;
+        for (unsigned long i = 0; i < repetitions; i++) {
+            error += meter.getTotalError();
+        }
+        sink = error;
+    });
+}
+
+/**
+ * Feeds a jittered low-flow pulse train (in simulated time) to a counting and a capturing meter.
+ * Reports the relative standard deviation of their flow rate readings and the cost of the capturing count().
+ */
+static void lowFlow(Preset &preset, double share) {
+    FlowMeter counting(2, *preset.properties);
+    CaptureFlowMeter capturing(2, *preset.properties);
+    double frequency = share * preset.properties->capacity * preset.properties->kFactor;
+    std::minstd_rand random(42);
+    std::uniform_real_distribution<double> jitter(0.95, 1.05);
+
+    nativeSetMicros(0);
+
+    unsigned long next = (unsigned long) (1e6 / frequency);                 // time of the next pulse (in us)
+    unsigned long now = 0;
+    double sum[2] = {0.0, 0.0}, squares[2] = {0.0, 0.0};
+    unsigned int samples = 0;
+
+    for (unsigned int tick = 1; tick <= 600; tick++) {
+        unsigned long end = tick * period * 1000UL;
+
+        while (next < end) {
+            nativeAdvanceMicros(next - now);
+            now = next;
+            counting.count();
+            capturing.count();
+            next += (unsigned long) (1e6 / frequency * jitter(random));
+        }
+
+        nativeAdvanceMicros(end - now);
+        now = end;
+        counting.update(period);
+        capturing.update(period);
+
+        if (tick > 10) {                                                    // skip the warm-up
+            double readings[2] = {counting.getCurrentFlowrate(), capturing.getCurrentFlowrate()};
+
+            for (unsigned int i = 0; i < 2; i++) {
+                sum[i] += readings[i];
+                squares[i] += readings[i] * readings[i];
+            }
+            samples++;
+        }
+    }
+
+    double deviation[2];
+
+    for (unsigned int i = 0; i < 2; i++) {
+        double mean = sum[i] / samples;
+        deviation[i] = sqrt(max(0.0, squares[i] / samples - mean * mean)) / mean;
+    }
+
+    double cost = measure(repetitions, [&]() {
+        for (unsigned long i = 0; i < repetitions; i++) {
+            capturing.count();
+        }
+    });
+
+    printf("%-20s %8.2f Hz %11.1f%% %11.1f%% %9.2f ns %s\n", preset.name, frequency, deviation[0] * 100.0, deviation[1] * 100.0, cost,
+           fabs(counting.getTotalVolume() - capturing.getTotalVolume()) < 1e-9 ? "" : "(totals differ)");
+}
+
+/**
+ * Fires count() from a second thread while update() samples the counter, and reports the cost of update() under contention
+ * (test/test_concurrency checks that every pulse is seen exactly once).
+ */
+template <class Meter>
+static void concurrency(const char *name) {
+    const unsigned long total = 20000000;                                   // pulses fired by the counting thread
+    Meter meter(2, UncalibratedSensor);
+    std::atomic<bool> done(false);
+    unsigned long updates = 0;
+
+    std::thread counter([&]() {
+        for (unsigned long i = 0; i < total; i++) {
+            meter.count();
+        }
+        done = true;
+    });
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    while (!done) {
+        meter.update(period);
+        updates++;
+    }
+
+    double cost = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / updates;
+
+    counter.join();
+    sink = meter.getTotalVolume();
+
+    printf("%-20s %12lu %12lu %9.2f ns\n", name, total, updates, cost);
+}
+
+/**
+ * Exposes the pulse counters of a bank.
+ */
+template <uint8_t Channels>
+class InjectedBank : public FlowMeterBank<Channels> {
+  public:
+    void inject(uint8_t channel, unsigned long pulses) {
+        this->_pulses[channel].add(pulses);
+    }
+};
+
+/**
+ * Compares one tick of a bank against one tick of as many separate meters (cost per channel).
+ */
+template <uint8_t Channels>
+static void bank(const unsigned long *pulses) {
+    static InjectedBank<Channels> bank;
+    static Injected<FlowMeter> *meters[Channels];
+
+    for (uint8_t channel = 0; channel < Channels; channel++) {
+        Preset &preset = presets[channel % (sizeof(presets) / sizeof(presets[0]))];
+        bank.attach(channel, channel, *preset.properties);
+        meters[channel] = new Injected<FlowMeter>(channel, *preset.properties);
+    }
+
+    double separate = measure(repetitions / Channels * Channels, [&]() {
+        for (unsigned long i = 0; i < repetitions / Channels; i++) {
+            for (uint8_t channel = 0; channel < Channels; channel++) {
+                meters[channel]->inject(pulses[(i + channel) & (ticks - 1)]);
+                meters[channel]->update(period);
+            }
+        }
+        sink = meters[0]->getTotalVolume();
+    });
+
+    double banked = measure(repetitions / Channels * Channels, [&]() {
+        for (unsigned long i = 0; i < repetitions / Channels; i++) {
+            for (uint8_t channel = 0; channel < Channels; channel++) {
+                bank.inject(channel, pulses[(i + channel) & (ticks - 1)]);
+            }
+            bank.update(period);
+        }
+        sink = bank.getTotalVolume(0);
+    });
+
+    for (uint8_t channel = 0; channel < Channels; channel++) {
+        delete meters[channel];
+    }
+
+    printf("%-20u %9.2f ns %9.2f ns %9u B %9u B\n", Channels, separate, banked,
+           (unsigned int) sizeof(FlowMeter), (unsigned int) (sizeof(FlowMeterBank<Channels>) / Channels));
+}
+
+/**
+ * Times update() with a rolling statistics window attached (test/test_statistics checks the window's values).
+ */
+template <uint8_t Window>
+static void statistics(const unsigned long *pulses) {
+    static FlowStatistics<Window> window;
+    Injected<FlowMeter> plain(2, UncalibratedSensor);
+    Injected<FlowMeter> meter(2, UncalibratedSensor);
+
+    meter.setStatistics(&window);
+
+    double without = benchmarkUpdate(plain, pulses);
+    double with = benchmarkUpdate(meter, pulses);
+
+    printf("%-20u %9.2f ns %9.2f ns %9u B\n", Window, without, with, (unsigned int) sizeof(window));
+}
+
+/**
+ * Counts the writes to every byte of a storage, so that the wear of the busiest cell can be reported.
+ */
+class CountingStorage : public FlowFileStorage {
+  public:
+    CountingStorage(const char *path, unsigned int size) : FlowFileStorage(path, size), _wear(size, 0) {}
+
+    void write(unsigned int address, const uint8_t *data, unsigned int length) {
+        FlowFileStorage::write(address, data, length);
+        for (unsigned int i = 0; i < length && address + i < this->_wear.size(); i++) this->_wear[address + i]++;
+    }
+
+    unsigned long getWear() {
+        return *std::max_element(this->_wear.begin(), this->_wear.end());
+    }
+
+  protected:
+    std::vector<unsigned long> _wear;            // writes per byte
+};
+
+/**
+ * Runs a meter for the given number of ticks with a throttled totalizer in a 1 KiB file, and reports the cost, the writes and
+ * the time a reboot takes to find the newest snapshot (test/test_totalizer checks that the totals come back).
+ */
+static void persistence(const char *name, const unsigned long *pulses, unsigned long runs, double volume, unsigned long duration) {
+    char path[] = "/tmp/flowtotalizerXXXXXX";
+    int file = mkstemp(path);
+
+    if (file < 0) {
+        return;
+    }
+
+    close(file);
+    unlink(path);                                                           // start from erased memory
+
+    CountingStorage storage(path, 1024);
+    FlowTotalizer totalizer(storage);
+    Injected<FlowMeter> meter(2, FS400A_cal);
+
+    totalizer.setThrottle(volume, duration);
+
+    double cost = measure(runs, [&]() {
+        for (unsigned long i = 0; i < runs; i++) {
+            meter.inject(pulses[i & (ticks - 1)]);
+            meter.update(period);
+            totalizer.update(meter);
+        }
+    });
+
+    totalizer.snapshot(meter);                                              // e.g. on a brown-out warning
+
+    FlowTotalizer rebooted(storage);
+    Injected<FlowMeter> restored(2, FS400A_cal);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    rebooted.restore(restored);
+    double boot = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%-20s %9.2f ns %12lu %10lu x %9.1f us\n", name, cost, totalizer.getWriteCount(), storage.getWear(), boot);
+
+    unlink(path);
+}
+
+/**
+ * Compares the CPU time per second of flow of counting pulses in count() against reading a pulse source in update(),
+ * over an hour on a (simulated) counter (test/test_pulse_source checks that every pulse is seen).
+ */
+static void pulseSource(const char *name, FlowSensorProperties &properties, double share) {
+    const unsigned long seconds = 3600;                                     // simulated run time (in s)
+    double frequency = properties.capacity * properties.kFactor * share;    // (in 1/s)
+
+    nativeSetMicros(0);
+    FlowSimulatedPulseSource source(frequency);
+    Injected<FlowMeter> meter(2, properties);
+    unsigned long long seen = 0;
+
+    meter.setPulseSource(&source);
+
+    for (unsigned long tick = 0; tick < seconds; tick++) {
+        nativeAdvanceMicros(1000000);
+        meter.update(period);
+        seen += (unsigned long long) (meter.getCurrentFrequency() + 0.5);
+    }
+
+    double count = benchmarkCount(properties);
+    double update = measure(repetitions, [&]() {
+        for (unsigned long i = 0; i < repetitions; i++) {
+            nativeAdvanceMicros(1000000);
+            meter.update(period);
+        }
+        sink = meter.getTotalVolume();
+    });
+
+    printf("%-20s %8.1f Hz %9.0f ns %9.0f ns %12llu\n", name, frequency, frequency * count + update, update, seen);
+}
+
+static unsigned long dosingPulse;                                           // pulses fired so far in dosing()
+static unsigned long dosingReached;                                         // pulse that reached the target
+
+static void dosingCallback() {
+    dosingReached = dosingPulse;
+}
+
+/**
+ * Doses a volume at a steady flow rate, once with a volume target and once by polling the total volume after every tick,
+ * and reports how far either overshoots, and the cost of count() with a target armed (test/test_dosing checks the targets).
+ */
+static void dosing(const char *name, FlowSensorProperties &properties, double flowrate, double dose) {
+    unsigned int decile = std::min(9u, (unsigned int) (10.0 * flowrate / properties.capacity));
+    double frequency = flowrate * properties.kFactor / properties.mFactor[decile];  // sensor model, see FlowFleet
+    double perPulse = 1.0 / (60.0 * properties.kFactor / properties.mFactor[decile]);   // volume per pulse (in l)
+    FlowMeter meter(2, properties);
+    unsigned long polled = 0;
+    double carry = 0.0;
+
+    for (unsigned long i = 0; i < (unsigned long) (frequency + 0.5); i++) meter.count();
+    meter.update(period);                                                   // one tick of flow, so that the target uses its correction
+
+    dosingPulse = 0;
+    dosingReached = 0;
+    meter.setTarget(dose, dosingCallback);
+    double start = meter.getTotalVolume();
+
+    while (dosingReached == 0 || polled == 0) {
+        double due = frequency + carry;
+        unsigned long pulses = (unsigned long) due;
+        carry = due - pulses;
+
+        for (unsigned long i = 0; i < pulses; i++) {
+            dosingPulse++;
+            meter.count();
+        }
+
+        meter.update(period);
+
+        if (polled == 0 && meter.getTotalVolume() - start >= dose) {
+            polled = dosingPulse;                                           // polling only notices at the end of the tick
+        }
+    }
+
+    double exact = dose / perPulse;                                         // pulses that make up the dose
+
+    FlowMeter armed(2, properties);
+    armed.setTarget(1e9);                                                   // never reached
+    double cost = measure(repetitions, [&]() {
+        for (unsigned long i = 0; i < repetitions; i++) {
+            armed.count();
+        }
+        sink = armed.getTargetPulses();
+    });
+
+    printf("%-20s %6.2f l/min %10.1f ml %10.1f ml %9.2f ns\n", name, flowrate, (dosingReached - exact) * perPulse * 1000.0,
+           (polled - exact) * perPulse * 1000.0, cost);
+}
+
+/**
+ * Runs a loop with random work (and the odd long stall) for a simulated day across the 32-bit millis() rollover,
+ * once with a scheduler and once with delay(period) and the nominal period, compares the average flow rates
+ * and reports the cost of an idle poll() (test/test_scheduler checks the schedule).
+ */
+static void scheduling(const char *name, double frequency, bool adaptive) {
+    const unsigned long long day = 86400000ULL;                             // (in ms)
+    const unsigned long long start = (1ULL << 32) - 3600000ULL;             // an hour before millis() rolls over on the Arduino (in ms)
+    std::minstd_rand random(42);
+    std::uniform_int_distribution<unsigned long> work(1, 20);               // loop work (in ms)
+    std::bernoulli_distribution stall(0.0002);                              // e.g. a blocking network request
+
+    nativeSetMicros(start * 1000ULL);
+    FlowSimulatedPulseSource source(frequency);
+    FlowMeter scheduled(2, UncalibratedSensor);
+    FlowScheduler<1> scheduler(period);
+    unsigned long long periods = 0;
+    unsigned long ticks = 0;
+
+    scheduled.setPulseSource(&source);
+    scheduler.attach(scheduled);
+
+    if (adaptive) {
+        scheduler.setAdaptive(250, 10000, 100);
+    }
+
+    while (millis() - start < day) {
+        nativeAdvanceMicros((work(random) + (stall(random) ? 2500 : 0)) * 1000ULL);
+
+        if (scheduler.poll() > 0) {
+            periods += scheduler.getPeriod(0);
+            ticks++;
+        }
+    }
+
+    double flowrate = frequency / UncalibratedSensor.kFactor;               // true flow rate (in l/min)
+    double error = (scheduled.getTotalFlowrate() - flowrate) / flowrate * 100.0;
+
+    nativeSetMicros(start * 1000ULL);
+    FlowSimulatedPulseSource naiveSource(frequency);
+    FlowMeter naive(2, UncalibratedSensor);
+    random.seed(42);
+    naive.setPulseSource(&naiveSource);
+
+    while (millis() - start < day) {
+        nativeAdvanceMicros((work(random) + (stall(random) ? 2500 : 0) + period) * 1000ULL);   // work, then delay(period)
+        naive.update(period);                                               // nominal period
+    }
+
+    double naiveError = (naive.getTotalFlowrate() - flowrate) / flowrate * 100.0;   // the volume is right, but the time isn't
+
+    FlowMeter idle(2, UncalibratedSensor);
+    FlowScheduler<1> waiting(period);
+    waiting.attach(idle);
+    double cost = measure(repetitions, [&]() {
+        for (unsigned long i = 0; i < repetitions; i++) {
+            sink = waiting.poll();                                          // nothing due (simulated time stands still)
+        }
+    });
+
+    printf("%-20s %8.1f Hz %9llu ms %10.3f %% %10.3f %% %9.2f ns\n", name, frequency, ticks > 0 ? periods / ticks : 0, error, naiveError, cost);
+}
+
+/**
+ * Runs a meter for more than a year of one second ticks, and compares its totals against an exact (long double) sum
+ * and against a plain 32-bit float accumulator with a 32-bit millisecond duration (as FlowMeter used to keep them on AVR).
+ * test/test_totals checks the totals.
+ */
+static void longHorizon(const char *name, FlowSensorProperties &properties, const unsigned long *pulses) {
+    const unsigned long days = 400;
+    Injected<FlowMeter> meter(2, properties);
+    long double exact = 0.0L;                                               // exact total volume (in l)
+    float naiveVolume = 0.0f;
+    uint32_t naiveDuration = 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (unsigned long tick = 0; tick < days * 86400; tick++) {
+        meter.inject(pulses[tick & (ticks - 1)]);
+        meter.update(period);
+        exact += meter.getCurrentVolume();
+        naiveVolume += (float) meter.getCurrentVolume();
+        naiveDuration += period;
+    }
+
+    double cost = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (days * 86400);
+    double error = (double) ((meter.getTotalVolume() - exact) / exact);
+    double naiveError = (double) ((naiveVolume - exact) / exact);
+
+    printf("%-20s %9.3g l %12.2e %12.2e %9.1f d %9.2f ns\n", name, (double) exact, error, naiveError, naiveDuration / 86400000.0, cost);
+}
+
+/**
+ * A synthetic four day flow profile: a household's taps during the day (one use per 20 minutes, from 06:00 to 23:00),
+ * with an anomaly from the third night on.
+ */
+enum Anomaly {
+    Normal, Leaking, Bursting, Stalled
+};
+
+static const unsigned long anomalyOnset = 2 * 86400 + 2 * 3600;             // third day, 02:00 (in s)
+static const unsigned long anomalyDays = 4;
+
+static void household(std::minstd_rand &random, Anomaly anomaly, std::vector<double> &flow) {
+    std::uniform_int_distribution<unsigned long> start(0, 900), length(30, 300);    // (in s)
+    std::uniform_real_distribution<double> rate(3.0, 12.0);                 // (in l/min)
+
+    flow.assign(anomalyDays * 86400, 0.0);
+
+    for (unsigned long slot = 0; slot < anomalyDays * 72; slot++) {        // 20 minute slots
+        unsigned long begin = slot * 1200 + start(random), end = begin + length(random);
+        double tap = rate(random);
+
+        if (begin % 86400 < 6 * 3600 || begin % 86400 >= 23 * 3600) {
+            continue;                                                       // night
+        }
+
+        for (unsigned long tick = begin; tick < end; tick++) {
+            flow[tick] = tap;
+        }
+    }
+
+    for (unsigned long tick = anomalyOnset; tick < flow.size(); tick++) {
+        switch (anomaly) {
+            case Leaking:  flow[tick] += 0.5; break;                        // 2.4 pulses/s, so every one second tick sees some
+            case Bursting: flow[tick] += tick < anomalyOnset + 600 ? 25.0 : 0.0; break;   // a ten minute pipe burst at night
+            case Stalled:  flow[tick] = 0.0; break;                         // the sensor dies
+            default: break;
+        }
+    }
+}
+
+static uint8_t anomalyRaised;                                               // events raised so far in anomalies()
+static unsigned long anomalyTick;                                           // current tick in anomalies()
+static unsigned long anomalyFirst;                                          // tick of the first event
+
+static void anomalyCallback(uint8_t event) {
+    if (anomalyRaised == 0) {
+        anomalyFirst = anomalyTick;
+    }
+
+    anomalyRaised |= event;
+}
+
+/**
+ * Replays a synthetic profile through a meter with an anomaly detector and reports the events raised and their latency after the
+ * anomaly's onset, and the cost of the detector per tick, on its own and within update() (test/test_anomalies checks the events).
+ */
+static void anomalies(const char *name, Anomaly anomaly, const unsigned long *pulses) {
+    static const char *names[] = {"-", "leak", "burst", "leak+burst", "stuck", "leak+stuck", "burst+stuck", "all"};
+    std::minstd_rand random(42);
+    std::vector<double> flow;
+    household(random, anomaly, flow);
+
+    Injected<FlowMeter> meter(2, UncalibratedSensor);
+    FlowAnomalyDetector detector;
+    detector.setLeak(0.0, 7200000)->setStuck(86400000)->setCallback(anomalyCallback);   // 2 h of flow is a leak, a day without is a dead sensor
+    meter.setDetector(&detector);
+    double carry = 0.0;
+
+    anomalyRaised = 0;
+    anomalyFirst = 0;
+
+    for (anomalyTick = 0; anomalyTick < flow.size(); anomalyTick++) {
+        double due = flow[anomalyTick] * UncalibratedSensor.kFactor + carry;    // pulses of the tick (in 1/s)
+        unsigned long count = (unsigned long) due;
+        carry = due - count;
+
+        meter.inject(count);
+        meter.update(period);
+    }
+
+    FlowAnomalyDetector timed;
+    double cost = measure(repetitions, [&]() {
+        for (unsigned long i = 0; i < repetitions; i++) {
+            timed.add(flow[(i * 7919) % flow.size()], period);              // visit the whole profile
+        }
+        sink = timed.getCusum();
+    });
+
+    Injected<FlowMeter> plain(2, UncalibratedSensor), fed(2, UncalibratedSensor);
+    fed.setDetector(&timed);
+    double overhead = benchmarkUpdate(fed, pulses) - benchmarkUpdate(plain, pulses);
+
+    printf("%-20s %12s %10lu s %9.2f ns %9.2f ns %12u\n", name, names[anomalyRaised & 7],
+           anomalyRaised != 0 ? anomalyFirst - std::min(anomalyFirst, anomalyOnset) : 0, cost, overhead,
+           (unsigned int) sizeof(FlowAnomalyDetector));
+}
+
+/**
+ * Formats a value like the Arduino's String(double), i.e. with two decimals.
+ */
+static std::string decimals(double value) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.2f", value);
+    return text;
+}
+
+/**
+ * Records a day of readings of several meters, then sends them once as text lines (built by String concatenation, as in the examples)
+ * and once as telemetry frames. Reports bytes and time per reading (decoding per frame), and how many readings per second
+ * fit through a 115200 Bd serial port as frames (test/test_telemetry checks the round trip).
+ */
+static void telemetry(uint8_t meters, const unsigned long *pulses) {
+    const unsigned long frames = 86400 / 16;                                // a day of ticks, every 16th
+    std::vector<FlowTelemetryDecoder::Reading> truth(frames * meters);
+
+    for (uint8_t meter = 0; meter < meters; meter++) {
+        Injected<FlowMeter> flowMeter(2, UncalibratedSensor);
+
+        for (unsigned long tick = 0; tick < frames * 16; tick++) {
+            flowMeter.inject(pulses[(tick + meter * 613) & (ticks - 1)]);
+            flowMeter.update(period);
+
+            if (tick % 16 == 15) {
+                FlowTelemetryDecoder::Reading reading = {flowMeter.getTotalDuration64(), flowMeter.getTotalVolume(), flowMeter.getCurrentFlowrate(), true};
+                truth[tick / 16 * meters + meter] = reading;
+            }
+        }
+    }
+
+    size_t textBytes = 0;
+    double text = measure(frames * meters, [&]() {
+        for (unsigned long frame = 0; frame < frames; frame++) {
+            for (uint8_t meter = 0; meter < meters; meter++) {
+                const FlowTelemetryDecoder::Reading &reading = truth[frame * meters + meter];
+                std::string line = "Meter " + std::to_string(meter + 1) + " currently " + decimals(reading.currentFlowrate) + " l/min, " +
+                                   decimals(reading.totalVolume) + " l total.\r\n";
+                textBytes += line.size();
+            }
+        }
+    });
+
+    FlowTelemetry<16> encoder;
+    std::vector<uint8_t> stream(frames * FlowTelemetryBase::frameSize(meters));
+    size_t length = 0;
+    double encode = measure(frames * meters, [&]() {
+        for (unsigned long frame = 0; frame < frames; frame++) {
+            encoder.begin(stream.data() + length, stream.size() - length);
+
+            for (uint8_t meter = 0; meter < meters; meter++) {
+                const FlowTelemetryDecoder::Reading &reading = truth[frame * meters + meter];
+                encoder.add(reading.totalDuration, reading.totalVolume, reading.currentFlowrate);
+            }
+
+            length += encoder.end();
+        }
+    });
+
+    FlowTelemetryDecoder decoder;
+    size_t position = 0, step;
+    double decode = measure(frames, [&]() {
+        while ((step = decoder.decode(stream.data() + position, length - position)) > 0) {
+            position += step;
+            sink = decoder.getReading(0).totalVolume;
+        }
+    });
+
+    double textSize = (double) textBytes / (frames * meters), frameSize = (double) length / (frames * meters);
+
+    printf("%-20u %10.1f B %10.1f B %9.0f ns %9.0f ns %9.0f ns %10lu/s\n", meters, textSize, frameSize, text, encode, decode,
+           (unsigned long) (11520 / frameSize));
+}
+
+/**
+ * Plays ten minutes of pulses (at the given share of capacity, with 10 % jitter) in simulated time, with noise on top:
+ * ringing (each edge followed by a few spurious edges within 800 us, with the given probability) and random spikes (at the given rate).
+ * Counts the train with and without debouncing (setDebounce() with its default margin), and reports both errors and the cost
+ * of count() without and with debouncing (test/test_debounce checks the errors).
+ */
+static void debouncing(const char *name, FlowSensorProperties &properties, double share, double ringing, double spikes) {
+    const unsigned long long duration = 600000000ULL;                       // (in us)
+    std::minstd_rand random(42);
+    std::uniform_real_distribution<double> jitter(0.9, 1.1), after(20.0, 800.0);
+    std::bernoulli_distribution rings(ringing);
+    std::uniform_int_distribution<int> echoes(1, 3);
+    std::vector<unsigned long long> edges;
+    double interval = 1e6 / (share * properties.capacity * properties.kFactor);   // (in us)
+    unsigned long pulses = 0;
+
+    for (double time = interval; time < duration; time += interval * jitter(random)) {
+        edges.push_back((unsigned long long) time);
+        pulses++;
+
+        for (int echo = rings(random) ? echoes(random) : 0; echo > 0; echo--) {
+            edges.push_back((unsigned long long) (time + after(random)));
+        }
+    }
+
+    if (spikes > 0.0) {
+        std::exponential_distribution<double> gap(spikes / 1e6);
+
+        for (double time = gap(random); time < duration; time += gap(random)) {
+            edges.push_back((unsigned long long) time);
+        }
+    }
+
+    std::sort(edges.begin(), edges.end());
+
+    nativeSetMicros(0);
+    FlowMeter plain(2, properties), filtered(2, properties);
+    filtered.setDebounce();
+
+    for (unsigned long long edge : edges) {
+        nativeSetMicros(edge);
+        plain.count();
+        filtered.count();
+    }
+
+    plain.update(duration / 1000);
+    filtered.update(duration / 1000);
+
+    double plainError = ((double) plain.getTotalPulses() - pulses) / pulses * 100.0;
+    double error = ((double) filtered.getTotalPulses() - pulses) / pulses * 100.0;
+
+    unsigned long step = filtered.getDebounceInterval() + 1;                // every timed pulse is accepted
+    double cost = measure(repetitions, [&]() {
+        for (unsigned long i = 0; i < repetitions; i++) {
+            nativeAdvanceMicros(step);
+            plain.count();
+        }
+    });
+    double debounced = measure(repetitions, [&]() {
+        for (unsigned long i = 0; i < repetitions; i++) {
+            nativeAdvanceMicros(step);
+            filtered.count();
+        }
+    });
+
+    printf("%-20s %9lu us %11.2f%% %11.2f%% %12lu %9.2f ns %9.2f ns\n", name, filtered.getDebounceInterval(), plainError, error,
+           filtered.getRejectedPulses(), cost, debounced);
+}
+
+/**
+ * Simulates a sensor with the given (true) properties, i.e. the volume that its pulses at a pulse rate stand for (as FlowMeter models it,
+ * with the decile picked from the pulse rate).
+ */
+static double trueVolume(const FlowSensorProperties &properties, double frequency, double pulses) {
+    unsigned int decile = std::min(9u, (unsigned int) (10.0 * frequency / (properties.capacity * properties.kFactor)));
+    return pulses * properties.mFactor[decile] / (60.0 * properties.kFactor);   // V = p * m / (60 * K), see FlowMeter::update()
+}
+
+/**
+ * Fits a sensor from reference runs at random pulse rates (with 0.2 % noise on both the sensor and the reference),
+ * starting from a datasheet k-factor that is 5 % off (with the right pulse rate at capacity) and no meter factors. Reports the worst
+ * decile deviation of the volume per pulse and its standard error, then applies the fit to a running meter and compares an hour of
+ * varying flow against the uncalibrated meter (test/test_calibration_fitter checks the bounds).
+ */
+static void calibrationFit(const char *name, const FlowSensorProperties &truth, unsigned int runs) {
+    std::minstd_rand random(42);
+    std::uniform_real_distribution<double> share(0.02, 1.0), length(30000.0, 120000.0);   // pulse rate (of capacity), run duration (in ms)
+    std::normal_distribution<double> noise(1.0, 0.002);
+    double fullScale = truth.capacity * truth.kFactor;                      // pulse rate at capacity (in 1/s)
+    FlowSensorProperties datasheet = {truth.capacity / 1.05, truth.kFactor * 1.05, {1, 1, 1, 1, 1, 1, 1, 1, 1, 1}};
+    FlowCalibrationFitter fitter(datasheet);
+
+    for (unsigned int run = 0; run < runs; run++) {
+        double frequency = share(random) * fullScale;
+        unsigned long duration = length(random);
+        double pulses = frequency * duration / 1000.0;
+        unsigned long counted = (unsigned long) (pulses * noise(random) + 0.5);
+
+        fitter.addRun(counted, duration, trueVolume(truth, counted * 1000.0 / duration, pulses) * noise(random));
+    }
+
+    FlowSensorProperties fitted = fitter.getProperties();
+    double worst = 0.0, worstError = 0.0;
+
+    for (uint8_t decile = 0; decile < 10; decile++) {
+        double deviation = (truth.kFactor / truth.mFactor[decile]) / (fitted.kFactor / fitted.mFactor[decile]) - 1.0;   // volume per pulse
+        double error = fitter.getMeterFactorError(decile) / fitted.mFactor[decile];
+
+        worst = std::max(worst, fabs(deviation));
+        worstError = std::max(worstError, error);
+    }
+
+    Injected<FlowMeter> nominal(2, datasheet), calibrated(2, datasheet);
+    std::uniform_real_distribution<double> level(0.05, 1.0);
+    double exact = 0.0, carry = 0.0, frequency = 0.0;
+
+    calibrated.setProperties(fitted);
+
+    for (unsigned long tick = 0; tick < 3600; tick++) {
+        if (tick % 60 == 0) {
+            frequency = level(random) * fullScale;                          // a new flow rate every minute
+        }
+
+        double due = frequency + carry;                                     // one second of flow
+        unsigned long pulses = (unsigned long) due;
+        carry = due - pulses;
+        exact += trueVolume(truth, pulses, pulses);
+
+        nominal.inject(pulses);
+        nominal.update(period);
+        calibrated.inject(pulses);
+        calibrated.update(period);
+    }
+
+    double before = (nominal.getTotalVolume() - exact) / exact * 100.0, after = (calibrated.getTotalVolume() - exact) / exact * 100.0;
+
+    FlowCalibrationFitter timed(datasheet);
+    double cost = measure(repetitions, [&]() {
+        for (unsigned long i = 0; i < repetitions; i++) {
+            timed.addRun(1000 + (i & 1023), 60000, 0.5 + (i & 511) * 1e-3);
+        }
+        sink = timed.getKFactor();
+    });
+
+    printf("%-20s %12u %12.4f %11.3f%% %11.3f%% %11.2f%% %11.3f%% %9.2f ns\n", name, runs, fitted.kFactor, worst * 100.0, worstError * 100.0,
+           before, after, cost);
+}
+
+#if defined(FLOWMETER_INSTRUMENTATION)
+/**
+ * Plays a known pulse train in simulated time (one regular tick, one beyond capacity, one late) and reports the instrumentation counters
+ * (test/test_instrumentation checks them).
+ */
+static void instrumentation() {
+    const unsigned long train[3][3] = {                                     // pulses, pulse interval (in us), tick length (in us)
+        {100, 10000, 1000000}, {200, 5000, 1000000}, {50, 20000, 1500000}
+    };
+
+    nativeSetMicros(0);
+    Injected<FlowMeter> meter(2, FS400A_cal);                               // capacity is 127.5 pulses/s
+
+    for (const unsigned long *tick : train) {
+        for (unsigned long pulse = 0; pulse < tick[0]; pulse++) {
+            nativeAdvanceMicros(tick[1]);
+            meter.count();
+        }
+
+        nativeAdvanceMicros(tick[2] - tick[0] * tick[1]);
+        meter.update(period);
+    }
+
+    FlowInstrumentation counters = meter.getInstrumentation();
+
+    printf("%-20s %12lu %12lu %9lu us %9lu us %12lu %12lu\n", "FlowMeter", counters.interrupts, counters.updates,
+           counters.minInterval, counters.maxInterval, counters.overCapacity, counters.lateUpdates);
+}
+#endif
+
+int main() {
+    static unsigned long pulses[ticks];
+
+    printf("%-20s %-10s %12s %12s %12s %12s %12s\n", "preset", "pulses", "update", "static", "curve", "count", "totalError");
+
+    for (Preset &preset : presets) {
+        double fullScale = preset.properties->capacity * preset.properties->kFactor * period / 1000.0;   // pulses per tick at capacity
+
+        for (Distribution &distribution : distributions) {
+            std::minstd_rand random(42);                                    // identical pulse trains across runs
+            distribution.generate(random, fullScale, pulses);
+
+            printf("%-20s %-10s %9.2f ns %9.2f ns %9.2f ns %9.2f ns %9.2f ns\n", preset.name, distribution.name,
+                   benchmarkUpdate(*preset.properties, pulses),
+                   preset.benchmarkStaticUpdate(pulses),
+                   benchmarkCurveUpdate(*preset.properties, pulses),
+                   benchmarkCount(*preset.properties),
+                   benchmarkTotalError(*preset.properties, pulses));
+        }
+    }
+
+    printf("\n%-20s %11s %12s %12s %12s\n", "preset", "low flow", "counting", "capturing", "count");
+
+    for (Preset &preset : presets) {
+        lowFlow(preset, 0.03);
+    }
+
+    printf("\n%-20s %-10s %12s\n", "preset", "pulses", "fixed");
+
+    for (Preset &preset : presets) {
+        double fullScale = preset.properties->capacity * preset.properties->kFactor * period / 1000.0;
+
+        for (Distribution &distribution : distributions) {
+            std::minstd_rand random(42);
+            distribution.generate(random, fullScale, pulses);
+
+            Injected<FixedFlowMeter> meter(2, *preset.properties);
+
+            printf("%-20s %-10s %9.2f ns\n", preset.name, distribution.name, benchmarkUpdate(meter, pulses));
+        }
+    }
+
+    printf("\n%-20s %12s %12s %12s %12s\n", "channels", "meters", "bank", "meter RAM", "channel RAM");
+
+    std::minstd_rand random(42);
+    uniform(random, 100.0, pulses);
+    bank<8>(pulses);
+    bank<16>(pulses);
+
+    printf("\n%-20s %12s %12s %12s\n", "window", "update", "statistics", "window RAM");
+
+    random.seed(42);
+    bursty(random, 100.0, pulses);
+    statistics<8>(pulses);
+    statistics<60>(pulses);
+    statistics<255>(pulses);
+
+    printf("\n%-20s %12s %12s %12s %12s\n", "totalizer", "update", "snapshots", "cell wear", "boot");
+
+    random.seed(42);
+    uniform(random, 30.0 * 4.25, pulses);                                   // FS400A_cal up to capacity
+    persistence("1 l or 1 h", pulses, 30 * 86400, 1.0, 3600000);           // 30 days of one second ticks
+    persistence("100 l or 1 d", pulses, 30 * 86400, 100.0, 86400000);
+
+    printf("\n%-20s %11s %12s %12s %12s\n", "pulse source", "pulses", "count()/s", "counter/s", "seen");
+
+    pulseSource("FHKCS_1mm_0deg", FHKCS_1mm_0deg, 1.0);                    // at capacity
+    pulseSource("FS400A", FS400A, 1.0);
+    pulseSource("FS400A x 10", FS400A, 10.0);                              // stands in for a larger sensor at thousands of Hz
+
+    printf("\n%-20s %12s %13s %13s %12s\n", "dosing 1 l", "flow", "target", "polled", "armed count");
+
+    dosing("FS400A_cal", FS400A_cal, 10.0, 1.0);
+    dosing("FS400A_cal", FS400A_cal, 25.0, 1.0);
+    dosing("FHKCS_1mm_0deg", FHKCS_1mm_0deg, 0.3, 1.0);
+
+    printf("\n%-20s %11s %12s %12s %12s %12s\n", "scheduler", "pulses", "period", "rate error", "delay()", "idle poll");
+
+    scheduling("fixed", 50.0, false);
+    scheduling("adaptive", 50.0, true);
+    scheduling("adaptive", 2.0, true);                                      // trickle flow
+
+    printf("\n%-20s %13s %12s %12s %12s %12s\n", "400 days", "volume", "error", "float error", "32-bit days", "tick");
+
+    random.seed(42);
+    trickle(random, 30.0 * 4.25, pulses);
+    longHorizon("FS400A_cal trickle", FS400A_cal, pulses);
+    random.seed(42);
+    uniform(random, 30.0 * 4.25, pulses);
+    longHorizon("FS400A_cal uniform", FS400A_cal, pulses);
+
+    printf("\n%-20s %12s %12s %12s %12s %12s\n", "4 days", "events", "latency", "add", "in update", "detector RAM");
+
+    random.seed(42);
+    bursty(random, 100.0, pulses);
+    anomalies("household", Normal, pulses);
+    anomalies("leak 0.5 l/min", Leaking, pulses);
+    anomalies("burst 25 l/min", Bursting, pulses);
+    anomalies("stuck sensor", Stalled, pulses);
+
+    printf("\n%-20s %12s %12s %12s %12s %12s %12s\n", "telemetry meters", "text", "binary", "String", "encode", "decode", "at 115200 Bd");
+
+    random.seed(42);
+    bursty(random, 100.0, pulses);
+    telemetry(1, pulses);
+    telemetry(2, pulses);
+    telemetry(16, pulses);
+
+    printf("\n%-20s %12s %12s %12s %12s %12s %12s\n", "debouncing", "interval", "raw error", "error", "rejected", "count", "debounced");
+
+    debouncing("FS400A clean", FS400A, 1.0, 0.0, 0.0);
+    debouncing("FS400A ringing", FS400A, 0.5, 0.3, 0.0);
+    debouncing("FS400A spikes", FS400A, 0.5, 0.0, 20.0);
+    debouncing("FS400A both", FS400A, 0.8, 0.3, 20.0);
+    debouncing("FHKCS ringing", FHKCS_1mm_0deg, 0.8, 0.5, 2.0);
+
+    printf("\n%-20s %12s %12s %12s %12s %12s %12s %12s\n", "calibration fit", "runs", "kFactor", "decile dev", "std error", "datasheet", "fitted", "addRun");
+
+    calibrationFit("FS400A_cal", FS400A_cal, 200);
+    calibrationFit("FHKCS_1mm_0deg", FHKCS_1mm_0deg, 200);
+    calibrationFit("FHKCS_1mm_0deg", FHKCS_1mm_0deg, 2000);
+
+#if defined(FLOWMETER_INSTRUMENTATION)
+    printf("\n%-20s %12s %12s %12s %12s %12s %12s\n", "instrumentation", "interrupts", "updates", "min gap", "max gap", "over cap", "late");
+
+    instrumentation();
+#endif
+
+    printf("\n%-20s %12s %12s %12s\n", "concurrent", "pulses", "updates", "update");
+
+    concurrency<FlowMeter>("FlowMeter");
+    concurrency<FixedFlowMeter>("FixedFlowMeter");
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Simulates a fleet of virtual meters on 1 to N cores and reports meter-ticks/s, together with the fleet's volume and error statistics.
+ *
+ * Usage: fleet [meters] [hours] [period in ms]
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include "FlowFleet.h"
+
+int main(int argc, char **argv) {
+    size_t meters = argc > 1 ? strtoul(argv[1], NULL, 10) : 4096;
+    double hours = argc > 2 ? atof(argv[2]) : 24.0;
+    unsigned long period = argc > 3 ? strtoul(argv[3], NULL, 10) : 1000;
+    unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+
+    FlowFleet fleet(period, (unsigned long) (hours * 3600000.0 / period));
+    fleet.populate(meters);
+
+    printf("%zu meters, %.1f h in ticks of %lu ms\n\n", meters, hours, period);
+    printf("%8s %12s %16s %10s\n", "threads", "time", "meter-ticks/s", "speedup");
+
+    FlowFleet::Statistics statistics;
+    double single = 0.0;
+
+    for (unsigned int threads = 1; ; threads = std::min(cores, threads * 2)) {
+        statistics = fleet.run(threads);
+
+        double rate = statistics.ticks / statistics.seconds;
+        if (threads == 1) single = rate;
+
+        printf("%8u %10.3f s %16.3e %9.2fx\n", threads, statistics.seconds, rate, rate / single);
+
+        if (threads == cores) break;
+    }
+
+    printf("\nmetered %.3f l, true %.3f l (%+.4f %%), largest meter deviation %.4f %%\n", statistics.meteredVolume, statistics.trueVolume,
+           (statistics.meteredVolume / statistics.trueVolume - 1.0) * 100.0, statistics.maxDeviation);
+    printf("average error per meter: mean %.3f %%, min %.3f %%, max %.3f %%\n", statistics.meanError, statistics.minError, statistics.maxError);
+
+    return 0;
+}
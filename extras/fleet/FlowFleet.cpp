@@ -0,0 +1,173 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Host-only fleet simulator for capacity planning.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include "FlowFleet.h"
+#include "Injected.h"
+
+static const double pi = 3.14159265358979323846;
+
+struct FlowFleet::Shard {
+    unsigned long long ticks = 0;
+    double meteredVolume = 0.0;
+    double trueVolume = 0.0;
+    double maxDeviation = 0.0;
+    double sumError = 0.0;
+    double minError = 1e300;
+    double maxError = -1e300;
+};
+
+FlowFleet::FlowFleet(unsigned long period, unsigned long ticks) :
+    _period(period),
+    _ticks(ticks)
+{
+}
+
+FlowFleet* FlowFleet::add(const Profile &profile) {
+    this->_profiles.push_back(profile);
+    return this;
+}
+
+FlowFleet* FlowFleet::populate(size_t meters, uint32_t seed) {
+    static const FlowSensorProperties *sensors[] = {&UncalibratedSensor, &FS300A, &FS400A, &FS400A_cal, &FHKCS_1mm_0deg};
+    std::minstd_rand random(seed);
+    std::uniform_int_distribution<unsigned int> sensor(0, sizeof(sensors) / sizeof(sensors[0]) - 1);
+    std::uniform_int_distribution<unsigned int> shape(Constant, Trickle);
+    std::uniform_real_distribution<double> share(0.2, 0.95);
+    std::uniform_real_distribution<double> phase(0.0, 86400.0);
+
+    for (size_t meter = 0; meter < meters; meter++) {
+        Profile profile;
+
+        profile.properties = sensors[sensor(random)];
+        profile.shape = (Shape) shape(random);
+        profile.share = profile.shape == Trickle ? 0.03 : share(random);
+        profile.phase = phase(random);
+        profile.seed = random();
+
+        this->add(profile);
+    }
+
+    return this;
+}
+
+void FlowFleet::simulate(size_t first, size_t last, Shard &shard) {
+    double seconds = this->_period / 1000.0;
+
+    for (size_t index = first; index < last; index++) {
+        const Profile &profile = this->_profiles[index];
+        const FlowSensorProperties &properties = *profile.properties;
+        Injected<FlowMeter> meter(0, properties);
+        std::minstd_rand random(profile.seed);
+        std::exponential_distribution<double> cycle(1.0 / 600.0);          // valve cycles of 10 minutes on average (in s)
+        double capacity = properties.capacity * profile.share;             // peak flow (in l/min)
+        double carry = 0.0;                                                 // fractional pulses
+        double trueVolume = 0.0;                                            // (in l)
+        double toggle = cycle(random);                                      // time of the next valve change (in s)
+        bool open = true;
+
+        for (unsigned long tick = 0; tick < this->_ticks; tick++) {
+            double time = profile.phase + tick * seconds;                   // (in s)
+            double flow;                                                    // true flow rate (in l/min)
+
+            switch (profile.shape) {
+                case Daily:
+                    flow = capacity * 0.5 * (1.0 - cos(2.0 * pi * time / 86400.0));
+                    break;
+                case Bursty:
+                    while (time >= toggle + profile.phase) {
+                        open = !open;
+                        toggle += cycle(random);
+                    }
+                    flow = open ? capacity : 0.0;
+                    break;
+                default:
+                    flow = capacity;
+                    break;
+            }
+
+            /* sensor model: pulse rate from true flow, according to the sensor's calibration */
+            unsigned int decile = std::min(9u, (unsigned int) (10.0 * flow / properties.capacity));
+            double pulses = flow * properties.kFactor / properties.mFactor[decile] * seconds + carry;
+            unsigned long whole = (unsigned long) pulses;
+
+            carry = pulses - whole;
+            trueVolume += flow * seconds / 60.0;
+
+            meter.inject(whole);
+            meter.update(this->_period);
+        }
+
+        double metered = meter.getTotalVolume();
+        double error = meter.getTotalError();
+
+        shard.ticks += this->_ticks;
+        shard.meteredVolume += metered;
+        shard.trueVolume += trueVolume;
+        shard.sumError += error;
+        shard.minError = std::min(shard.minError, error);
+        shard.maxError = std::max(shard.maxError, error);
+
+        if (trueVolume > 0.0) {
+            shard.maxDeviation = std::max(shard.maxDeviation, fabs(metered - trueVolume) / trueVolume * 100.0);
+        }
+    }
+}
+
+FlowFleet::Statistics FlowFleet::run(unsigned int threads) {
+    size_t meters = this->_profiles.size();
+    threads = std::max(1u, std::min(threads, (unsigned int) std::max<size_t>(1, meters)));
+
+    std::vector<Shard> shards(threads);
+    std::vector<std::thread> workers;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (unsigned int worker = 0; worker < threads; worker++) {
+        size_t first = meters * worker / threads;
+        size_t last = meters * (worker + 1) / threads;
+
+        workers.emplace_back(&FlowFleet::simulate, this, first, last, std::ref(shards[worker]));
+    }
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    Statistics statistics;
+    Shard total;
+
+    statistics.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (Shard &shard : shards) {                                           // reduce in shard order, so results don't depend on thread timing
+        total.ticks += shard.ticks;
+        total.meteredVolume += shard.meteredVolume;
+        total.trueVolume += shard.trueVolume;
+        total.sumError += shard.sumError;
+        total.maxDeviation = std::max(total.maxDeviation, shard.maxDeviation);
+        total.minError = std::min(total.minError, shard.minError);
+        total.maxError = std::max(total.maxError, shard.maxError);
+    }
+
+    statistics.meters = meters;
+    statistics.ticks = total.ticks;
+    statistics.meteredVolume = total.meteredVolume;
+    statistics.trueVolume = total.trueVolume;
+    statistics.maxDeviation = total.maxDeviation;
+    statistics.meanError = meters > 0 ? total.sumError / meters : 0.0;
+    statistics.minError = meters > 0 ? total.minError : 0.0;
+    statistics.maxError = meters > 0 ? total.maxError : 0.0;
+
+    return statistics;
+}
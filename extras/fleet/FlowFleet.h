@@ -0,0 +1,88 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Host-only fleet simulator for capacity planning.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWFLEET_H_
+#define _FLOWFLEET_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "Arduino.h"
+#include "FlowMeter.h"
+
+/**
+ * FlowFleet
+ *
+ * Simulates a fleet of virtual flow meters with different sensors and flow profiles, in simulated time.
+ *
+ * Every virtual meter models its sensor by the sensor's own calibration (f = Q * K / m), carries fractional pulses
+ * from tick to tick and feeds them to a FlowMeter, so that the metered volume can be compared to the true volume.
+ * The meters are independent, so they are sharded across worker threads, each of which advances its meters
+ * through all ticks one after the other (keeping a meter's state in cache).
+ * Results don't depend on the number of threads (apart from the rounding of the fleet-wide sums).
+ */
+class FlowFleet {
+  public:
+    /**
+     * Shape of the flow over time.
+     */
+    enum Shape {
+        Constant,                                // steady flow
+        Daily,                                   // sinusoidal flow with a period of one day
+        Bursty,                                  // valve cycles of random length, separated by pauses
+        Trickle                                  // steady flow near the bottom of the sensor's range
+    };
+
+    /**
+     * A virtual meter: sensor, flow profile and random seed.
+     */
+    struct Profile {
+        const FlowSensorProperties *properties;  // sensor properties (referenced, not copied)
+        Shape shape;                             // shape of the flow over time
+        double share;                            // peak flow relative to the sensor's capacity
+        double phase;                            // time offset of the profile (in s)
+        uint32_t seed;                           // random seed (for Bursty)
+    };
+
+    /**
+     * Aggregated results of a run.
+     */
+    struct Statistics {
+        size_t meters;                           // number of simulated meters
+        unsigned long long ticks;                // number of simulated meter ticks
+        double seconds;                          // wall clock time taken (in s)
+        double meteredVolume;                    // total metered volume of the fleet (in l)
+        double trueVolume;                       // total true volume of the fleet (in l)
+        double maxDeviation;                     // largest deviation of a meter's metered from its true volume (in %)
+        double meanError;                        // mean of the meters' average errors (in %)
+        double minError;                         // smallest average error of a meter (in %)
+        double maxError;                         // largest average error of a meter (in %)
+    };
+
+    FlowFleet(unsigned long period = 1000, unsigned long ticks = 3600);  // Simulates the given number of ticks of the given period (in ms).
+
+    FlowFleet* add(const Profile &profile);      // Adds a virtual meter.
+    FlowFleet* populate(size_t meters, uint32_t seed = 42);  // Adds meters with all shipped sensors and shapes in random mix.
+
+    Statistics run(unsigned int threads);        // Simulates all meters on the given number of worker threads.
+
+  protected:
+    struct Shard;                                // partial results of one worker thread
+
+    void simulate(size_t first, size_t last, Shard &shard);  // Simulates a range of meters.
+
+    unsigned long _period;                       // tick period (in ms)
+    unsigned long _ticks;                        // ticks per meter
+    std::vector<Profile> _profiles;              // virtual meters
+};
+
+#endif   // _FLOWFLEET_H_
@@ -0,0 +1,105 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Host-only stand-in for a GPIO line, see FlowEventMock.h.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include "FlowEventMock.h"
+
+FlowEventMock::FlowEventMock(unsigned int offset) :
+    _offset(offset)
+{
+    if (pipe2(this->_pipe, O_CLOEXEC) < 0) {
+        this->_pipe[0] = this->_pipe[1] = -1;
+    }
+}
+
+FlowEventMock::~FlowEventMock() {
+    this->close();
+
+    if (this->_pipe[0] >= 0) {
+        ::close(this->_pipe[0]);
+    }
+}
+
+int FlowEventMock::getDescriptor() {
+    return this->_pipe[0];
+}
+
+bool FlowEventMock::edge(uint64_t timestamp) {
+    struct gpio_v2_line_event event;
+
+    this->fill(event, timestamp);
+    return this->send(&event, sizeof(event));
+}
+
+bool FlowEventMock::edges(unsigned long count, uint64_t start, uint64_t period) {
+    struct gpio_v2_line_event events[batchSize];
+
+    for (unsigned long i = 0; i < count; ) {
+        size_t batch = 0;
+
+        for (; batch < batchSize && i < count; batch++, i++) {
+            this->fill(events[batch], start + i * period);
+        }
+
+        if (!this->send(events, batch * sizeof(events[0]))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void FlowEventMock::skip(unsigned long count) {
+    this->_sequence += count;
+}
+
+void FlowEventMock::close() {
+    if (this->_pipe[1] >= 0) {
+        ::close(this->_pipe[1]);
+        this->_pipe[1] = -1;
+    }
+}
+
+unsigned long FlowEventMock::getEdgeCount() {
+    return this->_sequence;
+}
+
+void FlowEventMock::fill(struct gpio_v2_line_event &event, uint64_t timestamp) {
+    memset(&event, 0, sizeof(event));
+
+    event.timestamp_ns = timestamp;
+    event.id = GPIO_V2_LINE_EVENT_RISING_EDGE;
+    event.offset = this->_offset;
+    event.seqno = ++this->_sequence;                                        // one line, so both sequences agree
+    event.line_seqno = this->_sequence;
+}
+
+bool FlowEventMock::send(const void *data, size_t size) {
+    const uint8_t *bytes = (const uint8_t *) data;
+
+    while (size > 0) {
+        ssize_t written = write(this->_pipe[1], bytes, size);
+
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+
+        bytes += written;
+        size -= written;
+    }
+
+    return true;
+}
@@ -0,0 +1,63 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Host-only stand-in for a GPIO line, for FlowEventPulseSource without hardware.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWEVENTMOCK_H_
+#define _FLOWEVENTMOCK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <linux/gpio.h>
+
+/**
+ * FlowEventMock
+ *
+ * Writes GPIO line events into a pipe, in the same records that a line requested from the GPIO character device delivers,
+ * so that FlowEventPulseSource can be run on the read end instead, e.g.:
+ *
+ *   FlowEventMock Line;
+ *   FlowEventPulseSource Source(Line.getDescriptor());
+ *   Source.start();
+ *   Line.edges(1000, 0, 20000000);              // 1000 edges at 50 Hz
+ *
+ * Timestamps are given by the caller (in ns), so debouncing can be checked without waiting. Edges written with edges() are sent
+ * in batches of up to batchSize records per write(), and skip() leaves out edges as the kernel does when its event buffer overflows.
+ * The read end reaches its end once close() is called (or the mock is destroyed).
+ */
+class FlowEventMock {
+  public:
+    static const size_t batchSize = 64;          // records per write() at most
+
+    FlowEventMock(unsigned int offset = 0);      // Opens the pipe, for events of the given line offset.
+    ~FlowEventMock();                            // Closes both ends of the pipe.
+
+    FlowEventMock(const FlowEventMock &) = delete;   // the mock owns the pipe, so it can't be copied
+    FlowEventMock &operator=(const FlowEventMock &) = delete;
+
+    int getDescriptor();                         // Returns the read end of the pipe (-1 if it couldn't be opened).
+
+    bool edge(uint64_t timestamp);               // Writes one edge at the given time (in ns), returns false if the write failed.
+    bool edges(unsigned long count, uint64_t start, uint64_t period);  // Writes edges at start + i * period (in ns), in batches.
+    void skip(unsigned long count);              // Drops the given number of edges (they are missing from the sequence numbers).
+    void close();                                // Closes the write end, so that the reader sees the end of the pipe.
+
+    unsigned long getEdgeCount();                // Returns the number of edges so far, including skipped ones.
+
+  protected:
+    void fill(struct gpio_v2_line_event &event, uint64_t timestamp);  // Fills in the next edge.
+    bool send(const void *data, size_t size);    // Writes all of the given data.
+
+    int _pipe[2] = {-1, -1};                     // read and write end
+    unsigned int _offset;                        // line offset
+    uint32_t _sequence = 0;                      // line sequence number of the previous edge
+};
+
+#endif   // _FLOWEVENTMOCK_H_
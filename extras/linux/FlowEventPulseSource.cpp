@@ -0,0 +1,204 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Host-only pulse source for Linux, see FlowEventPulseSource.h.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include "FlowEventPulseSource.h"
+
+FlowEventPulseSource::FlowEventPulseSource(int descriptor, void (*callback)(void)) :
+    _descriptor(descriptor),
+    _callback(callback)
+{
+}
+
+FlowEventPulseSource::~FlowEventPulseSource() {
+    this->stop();
+}
+
+/**
+ * Requests a GPIO line from a chip of the GPIO character device (Linux 5.10 and later) as an input that reports edges.
+ *
+ * @param chip The chip device, e.g. "/dev/gpiochip0".
+ * @param offset The line on the chip (as listed by gpioinfo).
+ * @param flags The edges to report and the bias (GPIO_V2_LINE_FLAG_*, input is implied), by default rising edges with pull-up as in FlowMeter.
+ * @return The descriptor to read the line's events from (close it once done), or -1 (see errno).
+ */
+int FlowEventPulseSource::openLine(const char *chip, unsigned int offset, uint64_t flags) {
+    int descriptor = open(chip, O_RDONLY | O_CLOEXEC);
+
+    if (descriptor < 0) {
+        return -1;
+    }
+
+    struct gpio_v2_line_request request;
+    memset(&request, 0, sizeof(request));
+
+    request.offsets[0] = offset;
+    request.num_lines = 1;
+    request.config.flags = flags | GPIO_V2_LINE_FLAG_INPUT;
+    request.event_buffer_size = 1024;                                       // the kernel's largest, to ride out scheduling delays
+    strncpy(request.consumer, "FlowMeter", sizeof(request.consumer) - 1);
+
+    int result = ioctl(descriptor, GPIO_V2_GET_LINE_IOCTL, &request);
+    int error = errno;
+
+    close(descriptor);                                                      // the line stays requested through its own descriptor
+    errno = error;
+
+    return result < 0 ? -1 : request.fd;
+}
+
+bool FlowEventPulseSource::start() {
+    if (this->_running || this->_descriptor < 0) {
+        return false;
+    }
+
+    if (this->_thread.joinable()) {
+        this->_thread.join();                                               // ended by itself before
+    }
+
+    if (this->_wake[0] < 0 && pipe2(this->_wake, O_CLOEXEC) < 0) {
+        return false;
+    }
+
+    this->_running = true;
+    this->_thread = std::thread(&FlowEventPulseSource::run, this);
+
+    return true;
+}
+
+void FlowEventPulseSource::stop() {
+    if (this->_thread.joinable()) {
+        char wake = 0;
+        ssize_t written = write(this->_wake[1], &wake, 1);                  // wakes poll() up (the pipe is empty, so this can't fail)
+
+        (void) written;
+        this->_thread.join();
+    }
+
+    if (this->_wake[0] >= 0) {
+        close(this->_wake[0]);
+        close(this->_wake[1]);
+        this->_wake[0] = this->_wake[1] = -1;
+    }
+}
+
+bool FlowEventPulseSource::isRunning() {
+    return this->_running;
+}
+
+unsigned long FlowEventPulseSource::read() {
+    return this->_pulses.read();
+}
+
+FlowEventPulseSource* FlowEventPulseSource::setDebounceInterval(unsigned long interval) {
+    this->_debounceInterval = interval;
+    return this;
+}
+
+unsigned long FlowEventPulseSource::getRejectedPulses() {
+    return this->_rejected.read();
+}
+
+unsigned long FlowEventPulseSource::getLostEdges() {
+    return this->_lost.read();
+}
+
+unsigned long FlowEventPulseSource::getReadCount() {
+    return this->_reads.read();
+}
+
+/**
+ * Waits for events and counts them, one batch per wake-up, until stop() is called or the descriptor reaches its end (or fails).
+ */
+void FlowEventPulseSource::run() {
+    struct pollfd descriptors[2] = {{this->_descriptor, POLLIN, 0}, {this->_wake[0], POLLIN, 0}};
+    const size_t size = sizeof(struct gpio_v2_line_event);
+
+    while (true) {
+        if (poll(descriptors, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        if (descriptors[1].revents != 0) {
+            break;                                                          // stop()
+        }
+
+        ssize_t length = ::read(this->_descriptor, this->_buffer + this->_pending, sizeof(this->_buffer) - this->_pending);
+
+        if (length < 0) {
+            if (errno == EINTR || errno == EAGAIN) continue;
+            break;
+        }
+
+        if (length == 0) {
+            break;                                                          // the writer closed the pipe or FIFO
+        }
+
+        this->_reads.increment();
+        this->_pending += length;
+
+        size_t events = this->_pending / size;
+        unsigned long pulses = 0;
+
+        for (size_t i = 0; i < events; i++) {
+            struct gpio_v2_line_event event;
+            memcpy(&event, this->_buffer + i * size, size);                 // (the buffer isn't aligned for the record)
+
+            pulses += this->consume(event);
+        }
+
+        this->_pending -= events * size;
+        memmove(this->_buffer, this->_buffer + events * size, this->_pending);   // keep a record split across reads
+
+        if (pulses > 0) {
+            this->_pulses.add(pulses);                                      // one store per batch, for update() to read
+
+            if (this->_callback != NULL) {
+                for (unsigned long i = 0; i < pulses; i++) {
+                    this->_callback();
+                }
+            }
+        }
+    }
+
+    this->_running = false;
+}
+
+unsigned long FlowEventPulseSource::consume(const struct gpio_v2_line_event &event) {
+    unsigned long lost = 0;
+
+    if (this->_lineSequence != 0) {
+        uint32_t gap = event.line_seqno - this->_lineSequence - 1;          // edges the kernel dropped (wrap-around safe)
+
+        if (gap != 0 && gap < 0x80000000UL) {                             // (ignore sequence numbers going backwards)
+            lost = gap;
+            this->_lost.add(lost);
+        }
+    }
+
+    this->_lineSequence = event.line_seqno;
+
+    if (this->_debounceInterval != 0 && this->_debouncedNanos != 0 &&
+        event.timestamp_ns - this->_debouncedNanos < (uint64_t) this->_debounceInterval * 1000) {
+        this->_rejected.increment();
+        return lost;                                                        // a spurious edge
+    }
+
+    this->_debouncedNanos = event.timestamp_ns;
+    return lost + 1;
+}
@@ -0,0 +1,96 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Host-only pulse source for Linux, fed by GPIO line events (or a FIFO, see FlowEventMock).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWEVENTPULSESOURCE_H_
+#define _FLOWEVENTPULSESOURCE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+#include <linux/gpio.h>
+#include "FlowPulseCounter.h"
+#include "FlowPulseSource.h"
+
+/**
+ * FlowEventPulseSource
+ *
+ * Counts sensor pulses from edge events read from a file descriptor, on a reader thread of its own, e.g. on a Linux single board computer:
+ *
+ *   int line = FlowEventPulseSource::openLine("/dev/gpiochip0", 17);
+ *   FlowEventPulseSource Source(line);
+ *   Meter->setPulseSource(&Source);
+ *   Source.start();                             // then update() the meter as usual, e.g. with a FlowScheduler
+ *
+ * The descriptor delivers struct gpio_v2_line_event records, as a line requested from the GPIO character device does
+ * (see openLine()), or as a pipe or FIFO does that FlowEventMock writes to. The reader thread sleeps in poll() and drains up to
+ * batchSize events per read(), so a burst of edges costs one wake-up and one system call rather than one per edge. Records split
+ * across reads (as from a pipe) are put back together.
+ *
+ * Edges are counted into a FlowPulseCounter once per batch, and update() reads it without locks (see FlowPulseCounter).
+ * Edges that the kernel had to drop because its event buffer was full show up as gaps in the line sequence numbers,
+ * they are counted anyway (and in getLostEdges()). Debouncing works on the kernel's edge timestamps, not on the time of reading.
+ *
+ * Alternatively, a callback can be given that's called for every counted edge on the reader thread, like an interrupt service routine,
+ * e.g. one that calls Meter->count() (then don't set the source on the meter as well). That way volume targets fire with the very pulse,
+ * at the cost of a call per edge, but FlowMeter's own debouncing then sees the time of reading, so debounce here instead.
+ */
+class FlowEventPulseSource : public FlowPulseSource {
+  public:
+    static const size_t batchSize = 64;          // events drained per read() at most
+
+    FlowEventPulseSource(int descriptor, void (*callback)(void) = NULL);  // Reads events from the given descriptor (not owned), calls callback per edge.
+    ~FlowEventPulseSource();                     // Stops the reader thread.
+
+    FlowEventPulseSource(const FlowEventPulseSource &) = delete;  // the reader thread refers to the object, so it can't be copied
+    FlowEventPulseSource &operator=(const FlowEventPulseSource &) = delete;
+
+    static int openLine(const char *chip, unsigned int offset,
+                        uint64_t flags = GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_BIAS_PULL_UP);  // Requests a GPIO line as input with the given edge flags, returns its descriptor (-1 on failure).
+
+    bool start();                                // Starts the reader thread, returns false if it can't.
+    void stop();                                 // Stops the reader thread (and waits for it).
+    bool isRunning();                            // Tells whether the reader thread is running (it stops by itself at the end of a FIFO).
+
+    unsigned long read();
+
+    FlowEventPulseSource* setDebounceInterval(unsigned long interval);  // Rejects edges closer than interval (in us) to the previous counted one (0: off, set before start()).
+
+    unsigned long getRejectedPulses();           // Returns the number of edges rejected by debouncing so far.
+    unsigned long getLostEdges();                // Returns the number of edges the kernel dropped (and that were counted anyway) so far.
+    unsigned long getReadCount();                // Returns the number of read() calls that returned events so far.
+
+  protected:
+    void run();                                  // Reader thread: waits for events and counts them until stopped.
+    unsigned long consume(const struct gpio_v2_line_event &event);  // Returns the pulses an event stands for (including dropped ones before it).
+
+    int _descriptor;                             // event descriptor (not owned)
+    void (*_callback)(void);                     // called per counted edge (on the reader thread)
+    int _wake[2] = {-1, -1};                     // pipe that wakes the reader thread up to stop
+
+    std::thread _thread;                         // reader thread
+    std::atomic<bool> _running{false};           // whether the reader thread is running
+
+    uint8_t _buffer[batchSize * sizeof(struct gpio_v2_line_event)];  // events read but not yet counted (reader thread only)
+    size_t _pending = 0;                         // bytes in the buffer (reader thread only)
+
+    unsigned long _debounceInterval = 0;         // shortest counted interval between two edges (in us, 0: off)
+    uint64_t _debouncedNanos = 0;                // timestamp of the previous counted edge (in ns, reader thread only)
+    uint32_t _lineSequence = 0;                  // line sequence number of the previous event (0: none yet, reader thread only)
+
+    FlowPulseCounter _pulses;                    // pulses counted so far (written by the reader thread)
+    FlowPulseCounter _rejected;                  // edges rejected by debouncing (written by the reader thread)
+    FlowPulseCounter _lost;                      // edges dropped by the kernel (written by the reader thread)
+    FlowPulseCounter _reads;                     // read() calls that returned events (written by the reader thread)
+};
+
+#endif   // _FLOWEVENTPULSESOURCE_H_
@@ -0,0 +1,286 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Meters a flow sensor on a Linux GPIO line (or reads its edge events from a FIFO), and checks the event frontend against a mock line.
+ *
+ * Usage: gpio <chip> <line> [sensor] [period in ms]
+ *        gpio --fifo <path> [sensor] [period in ms]
+ *        gpio --mock
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <chrono>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <unistd.h>
+#include "Arduino.h"
+#include "FlowEventMock.h"
+#include "FlowEventPulseSource.h"
+#include "FlowMeter.h"
+#include "FlowScheduler.h"
+
+struct Preset {
+    const char *name;
+    FlowSensorProperties *properties;
+};
+
+static Preset presets[] = {
+    {"UncalibratedSensor", &UncalibratedSensor},
+    {"FS300A", &FS300A},
+    {"FS400A", &FS400A},
+    {"FS400A_cal", &FS400A_cal},
+    {"FHKCS_1mm_0deg", &FHKCS_1mm_0deg},
+};
+
+static const uint64_t millisecond = 1000000;     // (in ns)
+
+/**
+ * A mock line that can also split a record across two writes, as a pipe may deliver it.
+ */
+class SplittingMock : public FlowEventMock {
+  public:
+    bool split(uint64_t timestamp, size_t first) {
+        struct gpio_v2_line_event event;
+
+        this->fill(event, timestamp);
+
+        if (!this->send(&event, first)) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));         // let the reader see the first part on its own
+        return this->send((const uint8_t *) &event + first, sizeof(event) - first);
+    }
+};
+
+static FlowMeter *Meter;
+
+static void MeterISR() {
+    Meter->count();
+}
+
+/**
+ * Waits until the source has counted the expected number of pulses (or a second has passed).
+ */
+static bool settle(FlowEventPulseSource &source, unsigned long expected) {
+    for (int i = 0; i < 1000 && source.read() != expected; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return source.read() == expected;
+}
+
+static bool check(const char *name, bool passed) {
+    printf("%-40s %s\n", name, passed ? "ok" : "FAILED");
+    return passed;
+}
+
+/**
+ * Runs the frontend against mock lines, returns whether all checks passed.
+ */
+static bool mock() {
+    bool ok = true;
+
+    /* batching: many edges per read(), none lost, and the reader ends with the pipe */
+    {
+        const unsigned long count = 100000;
+        FlowEventMock line;
+        FlowEventPulseSource source(line.getDescriptor());
+
+        source.start();
+        line.edges(count, millisecond, millisecond);
+        line.close();
+
+        for (int i = 0; i < 1000 && source.isRunning(); i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        printf("%lu edges in %lu reads (%.1f edges per read)\n", count, source.getReadCount(), (double) count / source.getReadCount());
+        ok = check("batched reads", source.read() == count && source.getReadCount() <= count / 16) && ok;
+        ok = check("end of pipe stops reader", !source.isRunning()) && ok;
+    }
+
+    /* update() on this thread while the reader thread counts, without locks */
+    {
+        const unsigned long count = 200000;
+        FlowEventMock line;
+        FlowEventPulseSource source(line.getDescriptor());
+        FlowMeter meter(0, FS400A);
+
+        meter.setPulseSource(&source);
+        source.start();
+
+        std::thread writer([&line, count]() {
+            for (unsigned long i = 0; i < count; i += 1000) {
+                line.edges(1000, (i + 1) * millisecond, millisecond);
+            }
+        });
+
+        unsigned long updates = 0;
+
+        while (source.read() != count && updates < 10000000) {
+            meter.update(1);
+            updates++;
+        }
+
+        writer.join();
+        settle(source, count);
+        meter.update(1);
+
+        printf("%lu edges, %lu concurrent updates\n", count, updates);
+        ok = check("concurrent update()", meter.getTotalPulses() == count) && ok;
+    }
+
+    /* records split across reads */
+    {
+        SplittingMock line;
+        FlowEventPulseSource source(line.getDescriptor());
+
+        source.start();
+        line.edge(millisecond);
+        line.split(2 * millisecond, 20);
+        line.edge(3 * millisecond);
+
+        ok = check("split records", settle(source, 3)) && ok;
+    }
+
+    /* edges dropped by the kernel */
+    {
+        FlowEventMock line;
+        FlowEventPulseSource source(line.getDescriptor());
+
+        source.start();
+        line.edges(10, millisecond, millisecond);
+        line.skip(5);
+        line.edges(10, 20 * millisecond, millisecond);
+
+        ok = check("lost edges counted", settle(source, 25) && source.getLostEdges() == 5) && ok;
+    }
+
+    /* debouncing on the event timestamps: every edge at 50 Hz rings once, 50 us later */
+    {
+        FlowEventMock line;
+        FlowEventPulseSource source(line.getDescriptor());
+
+        source.setDebounceInterval(1000);
+        source.start();
+
+        for (uint64_t i = 1; i <= 500; i++) {
+            line.edge(i * 20 * millisecond);
+            line.edge(i * 20 * millisecond + 50000);
+        }
+
+        ok = check("debounce on timestamps", settle(source, 500) && source.getRejectedPulses() == 500) && ok;
+    }
+
+    /* count() per edge, so that a volume target is reached with the very pulse */
+    {
+        FlowEventMock line;
+        FlowEventPulseSource source(line.getDescriptor(), MeterISR);
+        FlowMeter meter(0, FS400A);
+
+        Meter = &meter;
+        meter.setTarget(1.0f);                                              // armed before the reader runs
+
+        unsigned long target = meter.getTargetPulses();
+
+        source.start();
+        line.edges(target - 1, millisecond, millisecond);
+        settle(source, target - 1);
+
+        bool early = !meter.isTargetReached();                              // the target state is atomic, so it's read while the reader runs
+
+        line.edge(target * millisecond);
+
+        for (int i = 0; i < 1000 && !meter.isTargetReached(); i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        bool reached = meter.isTargetReached();
+
+        source.stop();                                                      // before the meter goes
+        meter.update(1000);
+
+        ok = check("count() per edge with target", early && reached && meter.getTotalPulses() == target) && ok;
+    }
+
+    return ok;
+}
+
+/**
+ * Meters a sensor from the given event descriptor, printing a line per tick (until interrupted).
+ */
+static int meter(int descriptor, FlowSensorProperties &properties, unsigned long period) {
+    FlowEventPulseSource source(descriptor);
+    FlowMeter meter(0, properties);
+    FlowScheduler<1> scheduler(period);
+
+    source.setDebounceInterval(1e6 / (properties.capacity * properties.kFactor * 1.5));   // as FlowMeter::setDebounce()
+    meter.setPulseSource(&source);
+    scheduler.attach(meter);
+
+    if (!source.start()) {
+        fprintf(stderr, "can't start the reader thread\n");
+        return 1;
+    }
+
+    printf("%12s %12s %12s %10s %10s %10s\n", "flow l/min", "total l", "pulses", "reads", "rejected", "lost");
+
+    while (source.isRunning()) {
+        if (scheduler.poll() > 0) {
+            printf("%12.3f %12.3f %12lu %10lu %10lu %10lu\n", meter.getCurrentFlowrate(), meter.getTotalVolume(), source.read(),
+                   source.getReadCount(), source.getRejectedPulses(), source.getLostEdges());
+            fflush(stdout);
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "--mock") == 0) {
+        return mock() ? 0 : 1;
+    }
+
+    bool fifo = argc > 2 && strcmp(argv[1], "--fifo") == 0;
+
+    if (argc < 3) {
+        fprintf(stderr, "usage: gpio <chip> <line> [sensor] [period in ms]\n       gpio --fifo <path> [sensor] [period in ms]\n       gpio --mock\n");
+        return 2;
+    }
+
+    FlowSensorProperties *properties = &UncalibratedSensor;
+    unsigned long period = argc > 4 ? strtoul(argv[4], NULL, 10) : 1000;
+
+    if (argc > 3) {
+        properties = NULL;
+
+        for (size_t i = 0; i < sizeof(presets) / sizeof(presets[0]); i++) {
+            if (strcmp(argv[3], presets[i].name) == 0) properties = presets[i].properties;
+        }
+
+        if (properties == NULL) {
+            fprintf(stderr, "unknown sensor %s\n", argv[3]);
+            return 2;
+        }
+    }
+
+    int descriptor = fifo ? open(argv[2], O_RDONLY | O_CLOEXEC) : FlowEventPulseSource::openLine(argv[1], strtoul(argv[2], NULL, 10));
+
+    if (descriptor < 0) {
+        perror(argv[fifo ? 2 : 1]);
+        return 1;
+    }
+
+    int result = meter(descriptor, *properties, period);
+
+    close(descriptor);
+    return result;
+}
@@ -0,0 +1,88 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Minimal host stand-in for the Arduino core, see Arduino.h.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <chrono>
+#include <random>
+#include <thread>
+#include "Arduino.h"
+
+static void (*nativeCallbacks[NATIVE_INTERRUPTS])(void) = {};               // simulated interrupt vector table
+
+static const std::chrono::steady_clock::time_point nativeEpoch = std::chrono::steady_clock::now();
+static std::minstd_rand nativeRandom;
+
+static bool nativeSimulated = false;                                        // simulated time instead of the steady clock
+static unsigned long nativeMicros = 0;                                      // simulated time (in us)
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    (void) pin;                                                             // there are no pins on the host
+    (void) mode;
+}
+
+void attachInterrupt(int interrupt, void (*callback)(void), int mode) {
+    (void) mode;                                                            // edges are raised explicitly on the host
+
+    if (interrupt >= 0 && interrupt < NATIVE_INTERRUPTS) {
+        nativeCallbacks[interrupt] = callback;
+    }
+}
+
+void detachInterrupt(int interrupt) {
+    if (interrupt >= 0 && interrupt < NATIVE_INTERRUPTS) {
+        nativeCallbacks[interrupt] = NULL;
+    }
+}
+
+void noInterrupts() {
+    // nothing to mask: raised interrupts run on the calling thread, and state that count() shares with other threads
+    // (e.g. a FlowEventPulseSource's reader) is atomic on the host, see FlowPulseCounter and FlowTarget
+}
+
+void interrupts() {
+}
+
+unsigned long millis() {
+    if (nativeSimulated) return nativeMicros / 1000;
+    return (unsigned long) std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - nativeEpoch).count();
+}
+
+unsigned long micros() {
+    if (nativeSimulated) return nativeMicros;
+    return (unsigned long) std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - nativeEpoch).count();
+}
+
+void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+long random(long howbig) {
+    return howbig > 0 ? (long) (nativeRandom() % (unsigned long) howbig) : 0;
+}
+
+long random(long howsmall, long howbig) {
+    return howsmall < howbig ? howsmall + random(howbig - howsmall) : howsmall;
+}
+
+void nativeRaiseInterrupt(int interrupt) {
+    if (interrupt >= 0 && interrupt < NATIVE_INTERRUPTS && nativeCallbacks[interrupt] != NULL) {
+        nativeCallbacks[interrupt]();
+    }
+}
+
+void nativeSetMicros(unsigned long us) {
+    nativeSimulated = true;
+    nativeMicros = us;
+}
+
+void nativeAdvanceMicros(unsigned long us) {
+    nativeMicros += us;
+}
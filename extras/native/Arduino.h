@@ -0,0 +1,67 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Minimal host stand-in for the Arduino core, so that the library can be compiled and measured natively.
+ * Only the parts of the Arduino API that the library (and its host tools) actually use are provided.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _ARDUINO_NATIVE_H_
+#define _ARDUINO_NATIVE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+#define LOW          0
+#define HIGH         1
+#define CHANGE       1
+#define FALLING      2
+#define RISING       3
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define NATIVE_INTERRUPTS 16                     // number of simulated external interrupts
+
+#define digitalPinToInterrupt(p) ((p) < NATIVE_INTERRUPTS ? (p) : -1)
+
+template <class T, class L>
+auto min(const T &a, const L &b) -> decltype((b < a) ? b : a) {
+    return (b < a) ? b : a;
+}
+
+template <class T, class L>
+auto max(const T &a, const L &b) -> decltype((b < a) ? b : a) {
+    return (a < b) ? b : a;
+}
+
+void pinMode(uint8_t pin, uint8_t mode);
+void attachInterrupt(int interrupt, void (*callback)(void), int mode);
+void detachInterrupt(int interrupt);
+
+void noInterrupts();
+void interrupts();
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+
+/*
+ * host-only helpers (not part of the Arduino API)
+ */
+
+void nativeRaiseInterrupt(int interrupt);        // Invokes the callback attached to the given interrupt, as if the pin had fired.
+void nativeSetMicros(unsigned long us);          // Switches millis() and micros() to simulated time, starting at the given time (in us).
+void nativeAdvanceMicros(unsigned long us);      // Advances simulated time (in us).
+
+#endif   // _ARDUINO_NATIVE_H_
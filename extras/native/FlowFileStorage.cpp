@@ -0,0 +1,83 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Host storage backend for FlowTotalizer, see FlowFileStorage.h.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "FlowFileStorage.h"
+
+FlowFileStorage::FlowFileStorage(const char *path, unsigned int size) {
+    int file = open(path, O_RDWR | O_CREAT, 0644);
+    struct stat status;
+
+    if (file < 0) {
+        return;
+    }
+
+    if (fstat(file, &status) != 0 || (status.st_size < (off_t) size && ftruncate(file, size) != 0)) {
+        close(file);
+        return;
+    }
+
+    void *mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    close(file);                                                            // the mapping stays valid
+
+    if (mapping == MAP_FAILED) {
+        return;
+    }
+
+    this->_mapping = (uint8_t *) mapping;
+    this->_size = size;
+
+    if (status.st_size < (off_t) size) {
+        memset(this->_mapping + status.st_size, 0xff, size - status.st_size);   // fresh memory reads as erased
+    }
+}
+
+FlowFileStorage::~FlowFileStorage() {
+    if (this->_mapping != NULL) {
+        munmap(this->_mapping, this->_size);
+    }
+}
+
+bool FlowFileStorage::isOpen() {
+    return this->_mapping != NULL;
+}
+
+unsigned int FlowFileStorage::size() {
+    return this->_size;
+}
+
+void FlowFileStorage::read(unsigned int address, uint8_t *data, unsigned int length) {
+    if (address > this->_size || length > this->_size - address) {
+        memset(data, 0xff, length);                                         // outside the memory
+        return;
+    }
+
+    memcpy(data, this->_mapping + address, length);
+}
+
+void FlowFileStorage::write(unsigned int address, const uint8_t *data, unsigned int length) {
+    if (address > this->_size || length > this->_size - address) {
+        return;                                                             // outside the memory
+    }
+
+    memcpy(this->_mapping + address, data, length);
+}
+
+void FlowFileStorage::commit() {
+    if (this->_mapping != NULL) {
+        msync(this->_mapping, this->_size, MS_SYNC);                        // returns once the file is written
+    }
+}
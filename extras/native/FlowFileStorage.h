@@ -0,0 +1,48 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Host storage backend for FlowTotalizer, see FlowStorage.h.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWFILESTORAGE_H_
+#define _FLOWFILESTORAGE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "FlowStorage.h"
+
+/**
+ * FlowFileStorage
+ *
+ * A memory-mapped file as non-volatile memory, so that totalizers can be run (and power cycled) on Linux.
+ *
+ * A new file (or the part of an existing one beyond its previous size) reads as erased EEPROM, i.e. 0xff.
+ * Writes go straight into the shared mapping, commit() flushes them to the file and waits until they are written.
+ */
+class FlowFileStorage : public FlowStorage {
+  public:
+    FlowFileStorage(const char *path, unsigned int size = 1024);    // Maps (and if necessary creates or extends) the file.
+    ~FlowFileStorage();                                             // Unmaps the file.
+
+    FlowFileStorage(const FlowFileStorage &) = delete;
+    FlowFileStorage &operator=(const FlowFileStorage &) = delete;
+
+    bool isOpen();                                                  // Tells whether the file could be mapped.
+
+    unsigned int size();
+    void read(unsigned int address, uint8_t *data, unsigned int length);
+    void write(unsigned int address, const uint8_t *data, unsigned int length);
+    void commit();
+
+  protected:
+    uint8_t *_mapping = NULL;                    // memory mapping of the file
+    unsigned int _size = 0;                      // size of the mapping (in bytes)
+};
+
+#endif   // _FLOWFILESTORAGE_H_
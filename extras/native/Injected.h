@@ -0,0 +1,37 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Host helper for the tests, benchmarks and tools that feed meters per tick.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _INJECTED_H_
+#define _INJECTED_H_
+
+#include <utility>
+#include "FlowMeter.h"
+
+/**
+ * Injected
+ *
+ * Exposes the pulse counter of any meter, so that ticks can be fed (and update() run) without the count() loop.
+ *
+ * Takes the meter's own constructor arguments (forwarded as they are, so that a meter can refer to e.g. a calibration curve).
+ */
+template <class Meter>
+class Injected : public Meter {
+  public:
+    template <class... Args>
+    Injected(Args &&... args) : Meter(std::forward<Args>(args)...) {}
+
+    void inject(unsigned long pulses) {                 // Adds pulses to the current tick, as count() would.
+        this->_pulses.add(pulses);
+    }
+};
+
+#endif   // _INJECTED_H_
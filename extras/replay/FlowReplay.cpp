@@ -0,0 +1,166 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Host-only offline replay engine for recorded pulse streams.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "FlowReplay.h"
+#include "Injected.h"
+
+/**
+ * A FlowMeter whose pulses are injected per tick, rather than counted per interrupt.
+ */
+class FlowReplay::Meter : public Injected<FlowMeter> {
+  public:
+    using Injected<FlowMeter>::Injected;
+};
+
+FlowReplay::FlowReplay() {
+}
+
+FlowReplay::~FlowReplay() {
+    if (this->_mapping != NULL) {
+        munmap(this->_mapping, this->_mappingSize);
+    }
+}
+
+bool FlowReplay::open(const char *path) {
+    int file = ::open(path, O_RDONLY);
+    struct stat status;
+
+    if (file < 0) {
+        return false;
+    }
+
+    if (fstat(file, &status) != 0) {
+        close(file);
+        return false;
+    }
+
+    if (status.st_size % sizeof(uint64_t) != 0) {
+        close(file);
+        errno = EINVAL;                                                     // not a stream of timestamps
+        return false;
+    }
+
+    if (this->_mapping != NULL) {
+        munmap(this->_mapping, this->_mappingSize);
+        this->_mapping = NULL;
+    }
+
+    this->_mappingSize = status.st_size;
+    this->_count = status.st_size / sizeof(uint64_t);
+    this->_timestamps = NULL;
+
+    if (this->_mappingSize > 0) {
+        void *mapping = mmap(NULL, this->_mappingSize, PROT_READ, MAP_PRIVATE, file, 0);
+
+        if (mapping == MAP_FAILED) {
+            close(file);
+            this->_count = 0;
+            return false;
+        }
+
+        madvise(mapping, this->_mappingSize, MADV_SEQUENTIAL);              // a replay reads the stream once, front to back
+        this->_mapping = mapping;
+        this->_timestamps = (const uint64_t *) mapping;
+    }
+
+    close(file);                                                            // the mapping stays valid
+    return true;
+}
+
+void FlowReplay::setPulses(const uint64_t *timestamps, size_t count) {
+    if (this->_mapping != NULL) {                                           // a previously opened stream isn't replayed anymore
+        munmap(this->_mapping, this->_mappingSize);
+        this->_mapping = NULL;
+        this->_mappingSize = 0;
+    }
+
+    this->_timestamps = timestamps;
+    this->_count = count;
+}
+
+FlowReplay* FlowReplay::addCandidate(const FlowSensorProperties &properties) {
+    this->_candidates.emplace_back(new Meter(0, properties));
+    return this;
+}
+
+FlowReplay* FlowReplay::addCandidate(const FlowSensorProperties &properties, const FlowCalibrationCurve &curve) {
+    this->_curves.emplace_back(new FlowCalibrationCurve(curve));
+    this->_candidates.emplace_back(new Meter(0, properties, *this->_curves.back()));
+    return this;
+}
+
+void FlowReplay::run(unsigned long period) {
+    this->_ticks = 0;
+    this->_peakFlowrates.assign(this->_candidates.size(), 0.0);
+
+    for (std::unique_ptr<Meter> &candidate : this->_candidates) {
+        candidate->reset();
+        candidate->setTotalDuration(0)->setTotalVolume(0.0)->setTotalCorrection(0.0);
+    }
+
+    if (this->_count == 0 || period == 0) {
+        return;
+    }
+
+    const uint64_t *pulse = this->_timestamps;
+    const uint64_t *end = this->_timestamps + this->_count;
+    uint64_t length = period * 1000ULL;                                     // tick length (in us)
+    uint64_t boundary = (this->_timestamps[0] / length + 1) * length;       // end of the first tick
+
+    while (pulse < end) {
+        const uint64_t *next = std::lower_bound(pulse, end, boundary);      // first pulse of the next tick
+        unsigned long pulses = next - pulse;
+
+        for (size_t index = 0; index < this->_candidates.size(); index++) {
+            Meter &candidate = *this->_candidates[index];
+
+            candidate.inject(pulses);
+            candidate.update(period);
+            this->_peakFlowrates[index] = std::max(this->_peakFlowrates[index], candidate.getCurrentFlowrate());
+        }
+
+        pulse = next;
+        boundary += length;
+        this->_ticks++;
+    }
+}
+
+size_t FlowReplay::getPulseCount() {
+    return this->_count;
+}
+
+size_t FlowReplay::getCandidateCount() {
+    return this->_candidates.size();
+}
+
+unsigned long FlowReplay::getTickCount() {
+    return this->_ticks;
+}
+
+FlowReplay::Result FlowReplay::getResult(size_t candidate) {
+    Meter &meter = *this->_candidates[candidate];
+    Result result;
+
+    result.totalVolume = meter.getTotalVolume();
+    result.totalFlowrate = meter.getTotalFlowrate();
+    result.totalError = meter.getTotalError();
+    result.peakFlowrate = candidate < this->_peakFlowrates.size() ? this->_peakFlowrates[candidate] : 0.0;
+    result.totalDuration = meter.getTotalDuration();
+
+    return result;
+}
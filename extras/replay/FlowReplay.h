@@ -0,0 +1,75 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Host-only offline replay engine for recorded pulse streams.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWREPLAY_H_
+#define _FLOWREPLAY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include "Arduino.h"
+#include "FlowMeter.h"
+
+/**
+ * FlowReplay
+ *
+ * Re-runs a recorded pulse stream through the FlowMeter math for any number of calibration candidates in one pass.
+ *
+ * A pulse stream is a binary file of little-endian uint64_t pulse timestamps (in us), in ascending order.
+ * The file is memory-mapped, and the pulses of each tick are found by binary search, so a replay costs
+ * O(log n) per tick (plus one update() per tick and candidate) regardless of the pulse rate, and never waits for the wall clock.
+ */
+class FlowReplay {
+  public:
+    /**
+     * Result of replaying the stream through one candidate.
+     */
+    struct Result {
+        double totalVolume;                      // total volume (in l)
+        double totalFlowrate;                    // average flow rate (in l/min)
+        double totalError;                       // average error (in %)
+        double peakFlowrate;                     // highest flow rate of any tick (in l/min)
+        unsigned long totalDuration;             // replayed duration (in ms)
+    };
+
+    FlowReplay();
+    ~FlowReplay();                               // Unmaps the pulse stream (if any).
+
+    bool open(const char *path);                 // Maps a pulse stream file, returns false on failure (errno EINVAL: size not a multiple of 8).
+    void setPulses(const uint64_t *timestamps, size_t count);  // Replays pulses from memory instead (not copied), unmaps an opened stream.
+
+    FlowReplay* addCandidate(const FlowSensorProperties &properties);                                  // Adds a candidate calibration.
+    FlowReplay* addCandidate(const FlowSensorProperties &properties, const FlowCalibrationCurve &curve);  // Adds a candidate calibration curve (copied).
+
+    void run(unsigned long period = 1000);       // Replays the whole stream in ticks of the given period (in ms), aligned to multiples of it.
+
+    size_t getPulseCount();                      // Returns the number of pulses in the stream.
+    size_t getCandidateCount();                  // Returns the number of candidates.
+    unsigned long getTickCount();                // Returns the number of ticks replayed by the last run.
+    Result getResult(size_t candidate);          // Returns the result of a candidate after a run.
+
+  protected:
+    class Meter;                                 // a FlowMeter whose pulses are injected
+
+    const uint64_t *_timestamps = NULL;          // pulse timestamps (in us)
+    size_t _count = 0;                           // number of pulses
+    void *_mapping = NULL;                       // memory mapping of the pulse stream file
+    size_t _mappingSize = 0;                     // size of the memory mapping (in bytes)
+
+    std::vector<std::unique_ptr<Meter> > _candidates;
+    std::vector<std::unique_ptr<FlowCalibrationCurve> > _curves;   // the candidates' curves (which the meters refer to)
+    std::vector<double> _peakFlowrates;
+    unsigned long _ticks = 0;
+};
+
+#endif   // _FLOWREPLAY_H_
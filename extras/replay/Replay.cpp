@@ -0,0 +1,117 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Replays a recorded pulse stream through every shipped sensor preset (per decile and along its calibration curve).
+ *
+ * Usage: replay <stream> [period in ms]
+ *        replay --synthesize <stream> <hours> [pulse rate in 1/s]
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <chrono>
+#include <errno.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "FlowReplay.h"
+
+struct Preset {
+    const char *name;
+    FlowSensorProperties *properties;
+};
+
+static Preset presets[] = {
+    {"UncalibratedSensor", &UncalibratedSensor},
+    {"FS300A", &FS300A},
+    {"FS400A", &FS400A},
+    {"FS400A_cal", &FS400A_cal},
+    {"FHKCS_1mm_0deg", &FHKCS_1mm_0deg},
+};
+
+/**
+ * Writes a synthetic stream: valve cycles of random length with jittered pulses, separated by pauses.
+ */
+static int synthesize(const char *path, double hours, double frequency) {
+    FILE *file = fopen(path, "wb");
+
+    if (file == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    std::minstd_rand random(42);
+    std::uniform_real_distribution<double> jitter(0.9, 1.1);
+    std::exponential_distribution<double> cycle(1.0 / 600e6);               // valve open for 10 minutes on average (in us)
+    uint64_t end = (uint64_t) (hours * 3600e6);
+    uint64_t now = 0;
+    size_t count = 0;
+
+    while (now < end) {
+        uint64_t close = now + (uint64_t) cycle(random);
+
+        while (now < close && now < end) {
+            now += (uint64_t) (1e6 / frequency * jitter(random));
+            fwrite(&now, sizeof(now), 1, file);
+            count++;
+        }
+
+        now += (uint64_t) cycle(random);                                    // pause
+    }
+
+    fclose(file);
+    printf("%zu pulses written to %s\n", count, path);
+
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 4 && strcmp(argv[1], "--synthesize") == 0) {
+        return synthesize(argv[2], atof(argv[3]), argc > 4 ? atof(argv[4]) : 100.0);
+    }
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <stream> [period in ms]\n       %s --synthesize <stream> <hours> [pulse rate in 1/s]\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    FlowReplay replay;
+    unsigned long period = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000;
+
+    if (!replay.open(argv[1])) {
+        if (errno == EINVAL) {
+            fprintf(stderr, "%s: not a pulse stream (size is not a multiple of %zu bytes)\n", argv[1], sizeof(uint64_t));
+        } else {
+            perror(argv[1]);
+        }
+
+        return 1;
+    }
+
+    for (Preset &preset : presets) {
+        replay.addCandidate(*preset.properties);
+        replay.addCandidate(*preset.properties, FlowCalibrationCurve(*preset.properties));
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    replay.run(period);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%zu pulses, %lu ticks of %lu ms, %zu candidates in %.3f s (%.1f M pulses/s)\n\n", replay.getPulseCount(), replay.getTickCount(),
+           period, replay.getCandidateCount(), seconds, replay.getPulseCount() / seconds / 1e6);
+    printf("%-20s %-8s %14s %12s %12s %12s\n", "preset", "method", "volume", "flow rate", "peak", "error");
+
+    for (size_t candidate = 0; candidate < replay.getCandidateCount(); candidate++) {
+        FlowReplay::Result result = replay.getResult(candidate);
+
+        printf("%-20s %-8s %12.3f l %6.3f l/min %6.3f l/min %10.3f %%\n", presets[candidate / 2].name, candidate % 2 ? "curve" : "decile",
+               result.totalVolume, result.totalFlowrate, result.peakFlowrate, result.totalError);
+    }
+
+    return 0;
+}
@@ -0,0 +1,176 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Host-only decoder for FlowTelemetry frames.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "FlowChecksum.h"
+#include "FlowTelemetryDecoder.h"
+
+/**
+ * Decodes the first valid frame in the data.
+ *
+ * Call it in a loop, dropping the consumed bytes each time, until it returns 0; then append more data and go on.
+ *
+ * @param data The received bytes.
+ * @param length The number of bytes.
+ * @return The number of bytes consumed (skipped bytes plus the frame), 0 if the data doesn't hold a complete frame yet.
+ */
+size_t FlowTelemetryDecoder::decode(const uint8_t *data, size_t length) {
+    for (size_t start = 0; start < length; start++) {
+        size_t frameLength;
+
+        if (data[start] != FlowTelemetryBase::sync) {
+            continue;
+        }
+
+        switch (this->parse(data + start, length - start, frameLength)) {
+            case Complete:
+                this->_skipped += start;
+                this->apply();
+                return start + frameLength;
+
+            case Incomplete:
+                this->_skipped += start;
+                return start;                                               // keep the partial frame for the next call
+
+            case Invalid:
+                break;                                                      // a sync byte by chance, or a corrupt frame
+        }
+    }
+
+    this->_skipped += length;
+    return length;                                                          // nothing worth keeping
+}
+
+uint16_t FlowTelemetryDecoder::getSequence() {
+    return this->_sequence;
+}
+
+bool FlowTelemetryDecoder::isKeyframe() {
+    return this->_keyframe;
+}
+
+size_t FlowTelemetryDecoder::getMeterCount() {
+    return this->_count;
+}
+
+FlowTelemetryDecoder::Reading FlowTelemetryDecoder::getReading(size_t meter) {
+    Reading reading = {this->_durations[meter], this->_volumes[meter] / 1e6, this->_flowrates[meter] / 1000.0, this->_known[meter]};
+    return reading;
+}
+
+unsigned long FlowTelemetryDecoder::getFrameCount() {
+    return this->_frames;
+}
+
+unsigned long FlowTelemetryDecoder::getLostFrameCount() {
+    return this->_lost;
+}
+
+unsigned long FlowTelemetryDecoder::getSkippedByteCount() {
+    return this->_skipped;
+}
+
+FlowTelemetryDecoder::Result FlowTelemetryDecoder::parse(const uint8_t *data, size_t length, size_t &frameLength) {
+    if (length < FlowTelemetryBase::headerSize) {
+        return Incomplete;
+    }
+
+    if ((data[1] & ~FlowTelemetryBase::keyframe) != FlowTelemetryBase::version) {
+        return Invalid;
+    }
+
+    size_t count = data[4];
+    size_t position = FlowTelemetryBase::headerSize;
+
+    this->_scratch.resize(3 * count);
+
+    for (size_t value = 0; value < 3 * count; value++) {
+        Result result = get(data, length, position, this->_scratch[value]);
+
+        if (result != Complete) {
+            return result;
+        }
+    }
+
+    if (position + FlowTelemetryBase::checksumSize > length) {
+        return Incomplete;
+    }
+
+    if (flowChecksum(data, position) != (data[position] | data[position + 1] << 8)) {
+        return Invalid;
+    }
+
+    this->_scratchKeyframe = data[1] & FlowTelemetryBase::keyframe;
+    this->_scratchSequence = data[2] | data[3] << 8;
+    frameLength = position + FlowTelemetryBase::checksumSize;
+
+    return Complete;
+}
+
+void FlowTelemetryDecoder::apply() {
+    size_t count = this->_scratch.size() / 3;
+
+    if (this->_started && this->_scratchSequence != (uint16_t) (this->_sequence + 1)) {
+        this->_lost += (uint16_t) (this->_scratchSequence - this->_sequence - 1);
+        this->_known.assign(this->_known.size(), false);                   // the deltas of the lost frames are gone
+    }
+
+    if (count > this->_durations.size()) {
+        this->_durations.resize(count, 0);
+        this->_volumes.resize(count, 0);
+        this->_flowrates.resize(count, 0);
+        this->_known.resize(count, false);
+    }
+
+    for (size_t meter = 0; meter < count; meter++) {
+        const uint64_t *values = &this->_scratch[3 * meter];
+
+        if (this->_scratchKeyframe) {
+            this->_durations[meter] = values[0];
+            this->_volumes[meter] = zigzag(values[1]);
+            this->_known[meter] = true;
+        } else {
+            this->_durations[meter] += zigzag(values[0]);
+            this->_volumes[meter] += zigzag(values[1]);
+        }
+
+        this->_flowrates[meter] = zigzag(values[2]);
+    }
+
+    this->_started = true;
+    this->_keyframe = this->_scratchKeyframe;
+    this->_sequence = this->_scratchSequence;
+    this->_count = count;
+    this->_frames++;
+}
+
+FlowTelemetryDecoder::Result FlowTelemetryDecoder::get(const uint8_t *data, size_t length, size_t &position, uint64_t &value) {
+    value = 0;
+
+    for (uint8_t shift = 0; shift < 70; shift += 7) {
+        if (position >= length) {
+            return Incomplete;
+        }
+
+        uint8_t byte = data[position++];
+        value |= (uint64_t) (byte & 0x7f) << shift;
+
+        if (!(byte & 0x80)) {
+            return Complete;
+        }
+    }
+
+    return Invalid;                                                         // longer than any 64-bit varint
+}
+
+int64_t FlowTelemetryDecoder::zigzag(uint64_t value) {
+    return (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+}
@@ -0,0 +1,80 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Host-only decoder for FlowTelemetry frames.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWTELEMETRYDECODER_H_
+#define _FLOWTELEMETRYDECODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "FlowTelemetry.h"
+
+/**
+ * FlowTelemetryDecoder
+ *
+ * Turns a byte stream of FlowTelemetry frames (see FlowTelemetryBase for the layout) back into meter readings.
+ *
+ * The stream may start mid-frame and may lose or corrupt bytes: the decoder skips to the next sync byte whose frame checks out.
+ * Totals are known from the first keyframe on, and again from the next keyframe after a lost frame (flow rates are always known).
+ */
+class FlowTelemetryDecoder {
+  public:
+    /**
+     * Reading of one meter in the most recent frame.
+     */
+    struct Reading {
+        uint64_t totalDuration;                  // total duration (in ms)
+        double totalVolume;                      // total volume (in l)
+        double currentFlowrate;                  // current flow rate (in l/min)
+        bool known;                              // whether the totals are known (i.e. synchronised by a keyframe)
+    };
+
+    size_t decode(const uint8_t *data, size_t length);   // Decodes the first frame in the data, returns the bytes consumed (0: need more data).
+
+    uint16_t getSequence();                      // Returns the sequence number of the most recent frame.
+    bool isKeyframe();                           // Tells whether the most recent frame was a keyframe.
+    size_t getMeterCount();                      // Returns the number of readings in the most recent frame.
+    Reading getReading(size_t meter);            // Returns a reading of the most recent frame.
+
+    unsigned long getFrameCount();               // Returns the number of frames decoded.
+    unsigned long getLostFrameCount();           // Returns the number of frames missing from the sequence.
+    unsigned long getSkippedByteCount();         // Returns the number of bytes skipped (garbage, corrupt or foreign frames).
+
+  protected:
+    enum Result { Complete, Incomplete, Invalid };
+
+    Result parse(const uint8_t *data, size_t length, size_t &frameLength);  // Checks and decodes a frame into the scratch readings.
+    void apply();                                // Applies the scratch readings to the meters.
+
+    static Result get(const uint8_t *data, size_t length, size_t &position, uint64_t &value);  // Reads a varint.
+    static int64_t zigzag(uint64_t value);       // Decodes a zigzag value.
+
+    std::vector<uint64_t> _durations;            // total duration of each position (in ms)
+    std::vector<int64_t> _volumes;               // total volume of each position (in ul)
+    std::vector<int32_t> _flowrates;             // flow rate of each position (in ml/min)
+    std::vector<bool> _known;                    // whether the totals of each position are known
+
+    std::vector<uint64_t> _scratch;              // readings of the frame being parsed (3 values per position)
+    bool _scratchKeyframe = false;
+    uint16_t _scratchSequence = 0;
+
+    bool _started = false;                       // whether a frame was decoded yet
+    bool _keyframe = false;                      // whether the most recent frame was a keyframe
+    uint16_t _sequence = 0;                      // sequence number of the most recent frame
+    size_t _count = 0;                           // readings in the most recent frame
+
+    unsigned long _frames = 0;
+    unsigned long _lost = 0;
+    unsigned long _skipped = 0;
+};
+
+#endif   // _FLOWTELEMETRYDECODER_H_
@@ -0,0 +1,75 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Decodes a capture of FlowTelemetry frames (e.g. the raw bytes received from the serial port) into CSV.
+ *
+ * Usage: telemetry <capture>   (- reads from stdin)
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "FlowTelemetryDecoder.h"
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <capture>   (- reads from stdin)\n", argv[0]);
+        return 2;
+    }
+
+    FILE *file = strcmp(argv[1], "-") == 0 ? stdin : fopen(argv[1], "rb");
+
+    if (file == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    FlowTelemetryDecoder decoder;
+    std::vector<uint8_t> pending;
+    uint8_t chunk[4096];
+    size_t length;
+
+    printf("sequence,meter,duration_ms,volume_l,flowrate_lpm\n");
+
+    while ((length = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        pending.insert(pending.end(), chunk, chunk + length);
+
+        size_t consumed = 0, step;
+        unsigned long frames = decoder.getFrameCount();
+
+        while ((step = decoder.decode(pending.data() + consumed, pending.size() - consumed)) > 0) {
+            consumed += step;
+
+            if (decoder.getFrameCount() == frames) {
+                continue;                                                   // skipped garbage only
+            }
+
+            frames = decoder.getFrameCount();
+
+            for (size_t meter = 0; meter < decoder.getMeterCount(); meter++) {
+                FlowTelemetryDecoder::Reading reading = decoder.getReading(meter);
+
+                if (reading.known) {
+                    printf("%u,%zu,%llu,%.6f,%.3f\n", decoder.getSequence(), meter, (unsigned long long) reading.totalDuration,
+                           reading.totalVolume, reading.currentFlowrate);
+                }
+            }
+        }
+
+        pending.erase(pending.begin(), pending.begin() + consumed);
+    }
+
+    if (file != stdin) {
+        fclose(file);
+    }
+
+    fprintf(stderr, "%lu frames, %lu lost, %lu bytes skipped\n", decoder.getFrameCount(), decoder.getLostFrameCount(), decoder.getSkippedByteCount());
+
+    return 0;
+}
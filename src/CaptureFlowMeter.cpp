@@ -0,0 +1,102 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "Arduino.h"
+#include "CaptureFlowMeter.h"                                               // https://github.com/sekdiy/FlowMeter
+
+CaptureFlowMeter::CaptureFlowMeter(unsigned int pin, FlowSensorProperties prop, void (*callback)(void), uint8_t interruptMode) :
+    FlowMeter(pin, prop, callback, interruptMode)
+{
+    this->reset();                                                          // ignore pulses generated during initialisation
+}
+
+/**
+ * The update method updates all internal calculations at the end of a measurement period.
+ *
+ * With p pulses in this tick, the last one at time t, and the last pulse of the previous tick at time t':
+ *
+ * f = p / (t - t')      | p full pulse periods end within this tick
+ *
+ * Without t' (i.e. after a reset or a long pause) the first pulse of this tick is used as start, if it is still buffered,
+ * otherwise (and with a single pulse) the pulses are divided by the tick duration as in FlowMeter::update().
+ *
+ * @param duration The update duration (in ms).
+ */
+void CaptureFlowMeter::update(unsigned long duration) {
+    /* sampling */
+    unsigned long pulses = this->sample();                                  // sample and reset current pulses
+
+    /* normalisation */
+    double seconds = duration / 1000.0f;                                    // normalised duration (in s, i.e. per 1000ms)
+    double frequency = pulses / seconds;                                    // normalised frequency (in 1/s), unless improved upon below
+
+    /* period estimation (buffer positions follow the pulse counter) */
+    if (pulses > 0) {
+        uint8_t tail = this->_sampledPulses - pulses;                       // buffer position of the first pulse in this tick
+        uint8_t last = this->_sampledPulses - 1;                            // buffer position of the last pulse in this tick
+        unsigned long first = this->_timestamps[tail & (captureSize - 1)];
+        unsigned long timestamp = this->_timestamps[last & (captureSize - 1)];
+        uint8_t head = this->_head;                                         // check for entries overwritten while reading
+        unsigned long later = this->_pulses.read() - this->_sampledPulses;  // pulses counted since the sample (in full width, before any 8-bit positions)
+
+        if (later < captureSize && (uint8_t) (head - last) <= captureSize) {
+            if (this->_lastValid && timestamp != this->_lastTimestamp) {
+                frequency = pulses * 1000000.0f / (timestamp - this->_lastTimestamp);
+            } else if (pulses > 1 && pulses <= captureSize && (uint8_t) (head - tail) <= captureSize && timestamp != first) {
+                frequency = (pulses - 1) * 1000000.0f / (timestamp - first);
+            }
+
+            this->_lastTimestamp = timestamp;
+            this->_lastValid = true;
+        } else {
+            this->_lastValid = false;                                       // pulses came too fast to tell, the tick duration will do
+        }
+
+        this->_idleDuration = 0;
+    } else {
+        this->_idleDuration += duration;
+
+        if (this->_lastValid && this->_idleDuration < 3600000UL) {          // micros() wraps around after about 70 minutes
+            double bound = 1000000.0f / (micros() - this->_lastTimestamp);  // the next pulse is due not earlier than now
+            frequency = min(this->_currentFrequency, bound);
+        } else {
+            this->_lastValid = false;
+        }
+    }
+
+    /* determine current correction factor (from sensor properties) */
+    this->_currentCorrection = this->correction(frequency);
+
+    /* update current calculations: */
+    this->_currentFlowrate = frequency / this->_currentCorrection;          // get flow rate (in l/min) from estimated frequency and combined correction factor
+    this->_currentVolume = pulses / this->_currentCorrection / 60.0f;       // get volume (in l) from counted pulses, i.e. V = p / K / 60
+
+    /* update statistics: */
+    this->record(duration, frequency);
+}
+
+void CaptureFlowMeter::count() {
+    unsigned long now = micros();                                           // this should be called from an interrupt service routine
+
+    if (this->_debounceInterval == 0 || !this->reject(now)) {               // a spurious edge's timestamp would spoil the period estimate
+        this->_timestamps[this->_head & (captureSize - 1)] = now;
+        this->_head++;                                                      // publish the timestamp before the pulse is counted (so _head follows the pulse counter)
+        this->accept();
+    }
+
+    FLOWMETER_INSTRUMENT(this->instrumentCount(now));
+}
+
+void CaptureFlowMeter::reset() {
+    FlowMeter::reset();                                                     // discards buffered timestamps along with their pulses
+
+    this->_lastValid = false;
+    this->_idleDuration = 0;
+}
@@ -0,0 +1,58 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _CAPTUREFLOWMETER_H_
+#define _CAPTUREFLOWMETER_H_
+
+#include "FlowMeter.h"
+
+/**
+ * CaptureFlowMeter
+ *
+ * A flow meter that timestamps every pulse (using micros()) and estimates the pulse rate from the pulse period.
+ *
+ * FlowMeter divides the pulses of a tick by its duration, so at low flow (a few pulses per tick) the reading jumps
+ * by up to 100% from tick to tick. Here the frequency is taken from the interval between the last pulse of the
+ * previous tick and the last pulse of the current tick instead, which is accurate to within one pulse.
+ * Ticks without any pulse let the reading decay with the time since the last pulse, rather than drop to zero.
+ *
+ * The volume is still derived from the counted pulses, so totals are the same as with FlowMeter.
+ *
+ * count() writes into a small single-producer ring buffer, update() reads from it without disabling interrupts.
+ */
+class CaptureFlowMeter : public FlowMeter {
+  public:
+    /**
+     * Initializes a new flow meter object.
+     *
+     * @param pin  The pin that the flow sensor is connected to (has to be interrupt capable, default: INT0).
+     * @param prop The properties of the actual flow sensor being used (default: UncalibratedSensor).
+     * @param callback The interrupt callback handler
+     */
+    CaptureFlowMeter(unsigned int pin = 2, FlowSensorProperties prop = UncalibratedSensor, void (*callback)(void) = NULL, uint8_t interruptMode = RISING);
+
+    void update(unsigned long duration = 1000);  // Updates all internal calculations at the end of a measurement period.
+    void count();                                // Records the pulse timestamp and increments the pulse counter. Serves as an interrupt callback routine.
+    void reset();                                // Prepares the flow meter for a fresh measurement. Resets all current values, but not the totals.
+
+    void tick(unsigned long duration = 1000) { update(duration); }
+
+    static const uint8_t captureSize = 4;        // number of buffered timestamps (power of two)
+
+  protected:
+    volatile unsigned long _timestamps[captureSize] = {0};  // pulse timestamps (in us), written by count()
+    volatile uint8_t _head = 0;                  // number of timestamps written so far (wraps around)
+
+    unsigned long _lastTimestamp = 0;            // timestamp of the last pulse of a previous tick (in us)
+    bool _lastValid = false;                     // whether _lastTimestamp can be used as a period start
+    unsigned long _idleDuration = 0;             // time since the last tick with pulses (in ms)
+};
+
+#endif   // _CAPTUREFLOWMETER_H_
@@ -0,0 +1,174 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <math.h>
+#include "Arduino.h"
+#include "FixedFlowMeter.h"                                                 // https://github.com/sekdiy/FlowMeter
+
+FixedFlowMeter::FixedFlowMeter(unsigned int pin, FlowSensorProperties prop, void (*callback)(void), uint8_t interruptMode) :
+    _pin(pin),                                                              // store pin number
+    _kFactor(prop.kFactor),                                                 // store k-factor (for the error getters)
+    _interruptCallback(callback),
+    _interruptMode(interruptMode)
+{
+    /* convert sensor properties into integer tables (see FlowMeter::update() for the formulae) */
+    this->_decileWidth = lround((double) prop.capacity * prop.kFactor / 10.0 * 65536.0);         // Q16.16 (in 1/s), the only rounding is to Q16.16
+
+    for (unsigned int decile = 0; decile < 10; decile++) {
+        this->_decileVolume[decile] = lround(prop.mFactor[decile] / (60.0 * prop.kFactor) * 1e9);    // V = p / t / K * t / 60 (in nl)
+        this->_decileCorrection[decile] = lround(prop.kFactor / prop.mFactor[decile] * 65536.0);      // Q16.16
+    }
+
+    pinMode(this->_pin, INPUT_PULLUP);                                      // initialize interrupt pin as input with pullup
+
+    if (this->_interruptCallback != NULL) {                                 // if ISR callback has been provided, attach it
+        attachInterrupt(digitalPinToInterrupt(this->_pin), this->_interruptCallback, this->_interruptMode);
+    }
+
+    this->reset();                                                          // ignore pulses generated during initialisation
+}
+
+FixedFlowMeter::~FixedFlowMeter() {
+    if (this->_interruptCallback != NULL) {                                 // if ISR callback has been provided, detach it
+        detachInterrupt(digitalPinToInterrupt(this->_pin));
+    }
+}
+
+double FixedFlowMeter::getCurrentFlowrate() {
+    if (this->_currentDuration == 0) return 0.0f;
+    return this->_currentVolume * (60.0 / 1e6) / this->_currentDuration; // in l/min, i.e. nl/ms * 60000 / 1e9
+}
+
+double FixedFlowMeter::getCurrentVolume() {
+    return this->_currentVolume / 1e9;                                     // in l
+}
+
+double FixedFlowMeter::getTotalFlowrate() {
+    return this->getTotalVolume() / (this->_totalDuration / 1000.0) * 60.0;  // in l/min
+}
+
+double FixedFlowMeter::getTotalVolume() {
+    return this->_totalVolume / 1e9;                                       // in l
+}
+
+/**
+ * The update method updates all internal calculations at the end of a measurement period.
+ *
+ * This is the calculation of FlowMeter::update(), rearranged so that it does without floating point:
+ *
+ * decile d = number of i in 1..9 with f >= i * C * K / 10
+ *          = number of i in 1..9 with p * 1000 >= i * (C * K / 10) * t   | t in ms
+ * V        = p * (m[d] / (60 * K))                                       | volume per pulse is tabulated in nl
+ *
+ * @param duration The update duration (in ms).
+ */
+void FixedFlowMeter::update(unsigned long duration) {
+    /* sampling */
+    unsigned long pulses = this->sample();                                  // sample and reset current pulses
+
+    /* determine decile by comparison (both sides scaled by 2^16) */
+    uint64_t scaled = (uint64_t) pulses * (1000UL << 16);                   // pulses * 1000, Q16.16
+    uint64_t width = (uint64_t) this->_decileWidth * duration;              // width of one decile in pulses * 1000 for this duration, Q16.16
+    uint64_t threshold = width;
+    unsigned int decile = 0;
+
+    while (decile < 9 && scaled >= threshold) {                             // highest possible decile index is 9
+        decile++;
+        threshold += width;
+    }
+
+    /* update current calculations: */
+    this->_currentCorrection = this->_decileCorrection[decile];
+    this->_currentVolume = (uint64_t) pulses * this->_decileVolume[decile];    // in nl
+
+    /* update statistics: */
+    this->_currentDuration = duration;
+    this->_tickPulses = pulses;
+    this->_totalDuration += duration;                                       // accumulate total duration (in ms)
+    this->_totalVolume += this->_currentVolume;                             // accumulate total volume (in nl)
+    this->_totalCorrection += (uint64_t) this->_currentCorrection * duration;  // accumulate corrections over time
+}
+
+unsigned long FixedFlowMeter::sample() {
+    unsigned long count = this->_source != NULL ?
+        this->_source->read() :                                             // sample external pulse source
+        this->_pulses.read();                                               // sample pulse counter (without disabling interrupts)
+    unsigned long pulses = count - this->_sampledPulses;                    // pulses since the last sample (wrap-around safe)
+    this->_sampledPulses = count;
+
+    return pulses;
+}
+
+void FixedFlowMeter::count() {
+    this->_pulses.increment();                                              // this should be called from an interrupt service routine
+}
+
+void FixedFlowMeter::reset() {
+    this->_sampledPulses = this->_source != NULL ? this->_source->read() : this->_pulses.read();   // skip pulses counted so far
+
+    this->_currentDuration = 0;
+    this->_tickPulses = 0;
+    this->_currentVolume = 0;
+    this->_currentCorrection = 0;
+}
+
+unsigned int FixedFlowMeter::getPin() {
+    return this->_pin;
+}
+
+FixedFlowMeter* FixedFlowMeter::setPulseSource(FlowPulseSource *source) {
+    this->_source = source;
+    this->_sampledPulses = source != NULL ? source->read() : this->_pulses.read();   // start counting from now
+    return this;
+}
+
+unsigned long FixedFlowMeter::getCurrentDuration() {
+    return this->_currentDuration;                                          // in ms
+}
+
+double FixedFlowMeter::getCurrentFrequency() {
+    if (this->_currentDuration == 0) return 0.0f;
+    return this->_tickPulses * 1000.0 / this->_currentDuration;            // in 1/s
+}
+
+double FixedFlowMeter::getCurrentError() {
+    return (this->_kFactor / (this->_currentCorrection / 65536.0) - 1) * 100;    // in %, see FlowMeter::getCurrentError()
+}
+
+unsigned long FixedFlowMeter::getTotalDuration() {
+    return this->_totalDuration;                                            // in ms
+}
+
+uint64_t FixedFlowMeter::getTotalDuration64() {
+    return this->_totalDuration;                                            // in ms
+}
+
+double FixedFlowMeter::getTotalError() {
+    return (this->_kFactor / (this->_totalCorrection / 65536.0) * this->_totalDuration - 1) * 100;   // in %, see FlowMeter::getTotalError()
+}
+
+double FixedFlowMeter::getTotalCorrection() {
+    return this->_totalCorrection / 65536.0;                                // Q16.16 * ms
+}
+
+FixedFlowMeter* FixedFlowMeter::setTotalDuration(uint64_t totalDuration) {
+    this->_totalDuration = totalDuration;
+    return this;
+}
+
+FixedFlowMeter* FixedFlowMeter::setTotalVolume(double totalVolume) {
+    this->_totalVolume = (uint64_t) (totalVolume * 1e9 + 0.5);            // in nl
+    return this;
+}
+
+FixedFlowMeter* FixedFlowMeter::setTotalCorrection(double totalCorrection) {
+    this->_totalCorrection = (uint64_t) (totalCorrection * 65536.0 + 0.5);  // Q16.16 * ms
+    return this;
+}
@@ -0,0 +1,110 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FIXEDFLOWMETER_H_
+#define _FIXEDFLOWMETER_H_
+
+#include <stdint.h>
+#include "FlowSensorProperties.h"
+#include "FlowPulseCounter.h"
+#include "FlowPulseSource.h"
+
+/**
+ * FixedFlowMeter
+ *
+ * A drop-in alternative to FlowMeter whose update() uses integer arithmetic only.
+ *
+ * The sensor properties are converted once (on construction) into per-decile integer tables:
+ * the volume per pulse (in nl), the combined correction factor (Q16.16) and the decile width (Q16.16, in 1/s).
+ * update() then determines the decile by comparison and accumulates volume and corrections as 64 bit integers,
+ * so totals don't lose resolution as they grow. The getters convert to floating point on demand.
+ *
+ * Error bounds relative to FlowMeter (with exact arithmetic):
+ * - volume: at most 0.5 nl per pulse (rounding of the volume per pulse), totals accumulate exactly,
+ * - correction: at most 2^-17 absolute (rounding of k-factor / m-factor),
+ * - decile selection: identical, except for frequencies within i * 2^-17 Hz of the i-th decile boundary (i.e. within 9 * 2^-17 Hz
+ *   at most): rounding the decile width to Q16.16 moves it by up to 2^-17 Hz, and the i-th boundary lies i widths up.
+ */
+class FixedFlowMeter {
+  public:
+    /**
+     * Initializes a new flow meter object.
+     *
+     * @param pin  The pin that the flow sensor is connected to (has to be interrupt capable, default: INT0).
+     * @param prop The properties of the actual flow sensor being used (default: UncalibratedSensor).
+     * @param callback The interrupt callback handler
+     */
+    FixedFlowMeter(unsigned int pin = 2, FlowSensorProperties prop = UncalibratedSensor, void (*callback)(void) = NULL, uint8_t interruptMode = RISING);
+    ~FixedFlowMeter();                           // Cleans up a flow meter object.
+
+    double getCurrentFlowrate();                 // Returns the current flow rate since last tick (in l/min).
+    double getCurrentVolume();                   // Returns the current volume since last tick (in l).
+
+    double getTotalFlowrate();                   // Returns the (linear) average flow rate in this flow meter instance (in l/min).
+    double getTotalVolume();                     // Returns the total volume flown trough this flow meter instance (in l).
+
+    void update(unsigned long duration = 1000);  // Updates all internal calculations at the end of a measurement period.
+    void count();                                // Increments the internal pulse counter. Serves as an interrupt callback routine.
+    void reset();                                // Prepares the flow meter for a fresh measurement. Resets all current values, but not the totals.
+
+    void tick(unsigned long duration = 1000) { update(duration); }
+
+    /*
+     * setters enabling continued metering across power cycles
+     */
+
+    FixedFlowMeter* setTotalDuration(uint64_t totalDuration);      // Sets the total (overall) duration (i.e. after power up).
+    FixedFlowMeter* setTotalVolume(double totalVolume);            // Sets the total (overall) volume (i.e. after power up).
+    FixedFlowMeter* setTotalCorrection(double totalCorrection);    // Sets the total (overall) correction factor (i.e. after power up).
+
+    /*
+     * convenience methods and calibration helpers
+     */
+
+    unsigned int getPin();                       // Returns the Arduino pin number that the flow sensor is connected to.
+
+    FixedFlowMeter* setPulseSource(FlowPulseSource *source);   // Reads pulses from the given source instead of counting them in count() (NULL to count again).
+
+    unsigned long getCurrentDuration();          // Returns the duration of the current tick (in ms).
+    double getCurrentFrequency();                // Returns the pulse rate in the current tick (in 1/s).
+    double getCurrentError();                    // Returns the error resulting from the current measurement (in %).
+
+    unsigned long getTotalDuration();            // Returns the total run time of this flow meter instance (in ms, wraps around after 49.7 days on the Arduino).
+    uint64_t getTotalDuration64();               // Returns the total run time of this flow meter instance (in ms, without wrapping around).
+    double getTotalError();                      // Returns the (linear) average error of this flow meter instance (in %).
+    double getTotalCorrection();                 // Returns the accumulated correction factors (i.e. for saving them with the totals).
+
+  protected:
+    unsigned long sample();                      // Fetches and clears the pulse counter of the current tick.
+
+    unsigned int _pin;                           // connection pin (has to be interrupt capable!)
+    double _kFactor;                             // "k-factor" of the sensor (for the error getters)
+    void (*_interruptCallback)(void);            // interrupt callback
+    uint8_t _interruptMode;                      // interrupt mode (LOW, CHANGE, RISING, FALLING, HIGH)
+
+    uint32_t _decileWidth;                       // width of a decile of flow (in 1/s, Q16.16)
+    uint32_t _decileVolume[10];                  // volume per pulse for each decile (in nl)
+    uint32_t _decileCorrection[10];              // combined correction factor for each decile (k-factor / m-factor, Q16.16)
+
+    unsigned long _currentDuration = 0;          // current tick duration (in ms)
+    unsigned long _tickPulses = 0;               // pulses sampled in the current tick
+    uint64_t _currentVolume = 0;                 // current volume (in nl)
+    uint32_t _currentCorrection = 0;             // currently applied correction factor (Q16.16)
+
+    uint64_t _totalDuration = 0;                 // total measured duration since begin of measurement (in ms)
+    uint64_t _totalVolume = 0;                   // total volume since begin of measurement (in nl)
+    uint64_t _totalCorrection = 0;               // accumulated correction factors over time (Q16.16 * ms)
+
+    FlowPulseCounter _pulses;                    // pulses since construction (written by count())
+    FlowPulseSource *_source = NULL;             // external pulse source (not owned, replaces _pulses if set)
+    unsigned long _sampledPulses = 0;            // pulse counter at the end of the previous sample period
+};
+
+#endif   // _FIXEDFLOWMETER_H_
@@ -0,0 +1,189 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <math.h>
+#include <stddef.h>
+#include "FlowAnomalyDetector.h"                                            // https://github.com/sekdiy/FlowMeter
+
+FlowAnomalyDetector::FlowAnomalyDetector() {
+}
+
+/**
+ * Adds a tick, in constant time.
+ *
+ * @param flowrate The flow rate of the tick (in l/min).
+ * @param duration The duration of the tick (in ms).
+ */
+void FlowAnomalyDetector::add(double flowrate, unsigned long duration) {
+    uint8_t events = this->_events;
+
+    /* leak: run length of flow above the leak flow rate (i.e. the minimum over the run stays above it) */
+    if (flowrate > this->_leakFlowrate) {
+        this->_minimumFlowrate = this->_flowingDuration > 0 ? (flowrate < this->_minimumFlowrate ? flowrate : this->_minimumFlowrate) : flowrate;
+        this->_flowingDuration = extend(this->_flowingDuration, duration);
+    } else {
+        this->_flowingDuration = 0;
+        this->_minimumFlowrate = flowrate;
+    }
+
+    if (this->_leakDuration > 0 && this->_flowingDuration >= this->_leakDuration) {
+        events |= Leak;
+    } else {
+        events &= ~Leak;
+    }
+
+    /* stuck: run length of ticks without flow */
+    if (flowrate > 0.0f) {
+        this->_idleDuration = 0;
+    } else {
+        this->_idleDuration = extend(this->_idleDuration, duration);
+    }
+
+    if (this->_stuckDuration > 0 && this->_idleDuration >= this->_stuckDuration) {
+        events |= Stuck;
+    } else {
+        events &= ~Stuck;
+    }
+
+    /* burst: one-sided CUSUM of the use (flow above the baseline) against normal use */
+    if (flowrate <= this->_baseline || this->_leakDuration == 0) {
+        this->_baseline = this->_leakDuration > 0 ? flowrate : 0.0f;      // the baseline follows the flow down at once...
+    } else {
+        double weight = (double) duration / this->_leakDuration;
+        this->_baseline += (flowrate - this->_baseline) * (weight < 1.0f ? weight : 1.0f);   // ...and up over the leak duration
+    }
+
+    double use = flowrate - this->_baseline;
+    double deviation = this->getDeviation();
+    double excess = use - (this->_mean + this->_allowance * deviation);
+
+    this->_cusum = this->_cusum + excess > 0.0f ? this->_cusum + excess : 0.0f;
+
+    if (this->_learned >= this->_warmup && this->_cusum > this->_limit * deviation) {
+        events |= Burst;
+    } else {
+        events &= ~Burst;
+    }
+
+    if (use > this->_floor && !(events & Burst)) {                          // learn normal use (Welford's update)
+        if (this->_learned < this->_warmup) {
+            this->_learned++;                                               // plain average until warmed up...
+        }
+
+        double weight = 1.0f / this->_learned > this->_alpha ? 1.0f / this->_learned : this->_alpha;   // ...then exponentially weighted
+        double difference = use - this->_mean;
+        double increment = weight * difference;
+
+        this->_mean += increment;
+        this->_variance = (1.0f - weight) * (this->_variance + difference * increment);
+    }
+
+    this->raise(events);
+}
+
+void FlowAnomalyDetector::clear() {
+    this->_events = None;
+    this->_flowingDuration = 0;
+    this->_minimumFlowrate = 0.0f;
+    this->_baseline = 0.0f;
+    this->_learned = 0;
+    this->_mean = 0.0f;
+    this->_variance = 0.0f;
+    this->_cusum = 0.0f;
+    this->_idleDuration = 0;
+}
+
+FlowAnomalyDetector* FlowAnomalyDetector::setLeak(double flowrate, unsigned long duration) {
+    this->_leakFlowrate = flowrate;
+    this->_leakDuration = duration;
+    return this;
+}
+
+FlowAnomalyDetector* FlowAnomalyDetector::setBurst(double allowance, double limit, double floor) {
+    this->_allowance = allowance;
+    this->_limit = limit;
+    this->_floor = floor;
+    return this;
+}
+
+FlowAnomalyDetector* FlowAnomalyDetector::setLearningRate(double alpha) {
+    double warmup = 1.0f / alpha;                                           // ticks until the plain average's weight drops to alpha
+
+    this->_alpha = alpha;
+    this->_warmup = warmup < 1.0f ? 1 : (warmup < 65535.0f ? warmup : 65535);
+    return this;
+}
+
+FlowAnomalyDetector* FlowAnomalyDetector::setStuck(unsigned long duration) {
+    this->_stuckDuration = duration;
+    return this;
+}
+
+FlowAnomalyDetector* FlowAnomalyDetector::setCallback(void (*callback)(uint8_t event)) {
+    this->_callback = callback;
+    return this;
+}
+
+uint8_t FlowAnomalyDetector::getEvents() {
+    return this->_events;
+}
+
+unsigned long FlowAnomalyDetector::getFlowingDuration() {
+    return this->_flowingDuration;
+}
+
+double FlowAnomalyDetector::getMinimumFlowrate() {
+    return this->_minimumFlowrate;
+}
+
+bool FlowAnomalyDetector::isLearned() {
+    return this->_learned >= this->_warmup;
+}
+
+unsigned long FlowAnomalyDetector::getIdleDuration() {
+    return this->_idleDuration;
+}
+
+double FlowAnomalyDetector::getBaseline() {
+    return this->_baseline;
+}
+
+double FlowAnomalyDetector::getMean() {
+    return this->_mean;
+}
+
+double FlowAnomalyDetector::getDeviation() {
+    double deviation = sqrt(this->_variance);
+    return deviation > this->_floor ? deviation : this->_floor;
+}
+
+double FlowAnomalyDetector::getCusum() {
+    return this->_cusum;
+}
+
+void FlowAnomalyDetector::raise(uint8_t events) {
+    uint8_t raised = events & ~this->_events;                               // newly raised events
+
+    this->_events = events;
+
+    if (this->_callback == NULL) {
+        return;
+    }
+
+    for (uint8_t event = Leak; event <= Stuck; event <<= 1) {
+        if (raised & event) {
+            this->_callback(event);
+        }
+    }
+}
+
+unsigned long FlowAnomalyDetector::extend(unsigned long run, unsigned long duration) {
+    return run + duration < run ? (unsigned long) -1 : run + duration;     // saturate
+}
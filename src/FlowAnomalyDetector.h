@@ -0,0 +1,94 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWANOMALYDETECTOR_H_
+#define _FLOWANOMALYDETECTOR_H_
+
+#include <stdint.h>
+
+/**
+ * FlowAnomalyDetector
+ *
+ * Watches the flow rate tick by tick for leaks, bursts and a stuck sensor, in constant memory and time.
+ *
+ * Leak:  the flow never dropped to (or below) the leak flow rate for the leak duration, i.e. the minimum flow over that window
+ *        stayed above it (e.g. continuous low flow through the night). Tracked as the run length of ticks above the leak flow rate.
+ * Burst: the use rose well above normal. Use is the flow above a baseline that follows the flow down at once and up over the leak
+ *        duration (i.e. a leak's constant flow, zero otherwise). Normal is the mean and variance of the use (Welford's update,
+ *        a plain average over the first 1/alpha ticks of use above the floor, exponentially weighted with alpha after that),
+ *        learned while there is no burst. A one-sided CUSUM sums up how far each tick's use exceeds mean + allowance * deviation,
+ *        and raises a burst once the sum exceeds limit * deviation. Bursts are only raised after the warm-up, and the deviation
+ *        is floored, so that steady use isn't a burst either.
+ * Stuck: there was no flow at all for the stuck duration (on a line that is never unused for that long).
+ *
+ * Attach it to a flow meter with FlowMeter::setDetector() (with FLOWMETER_HOOKS defined) and it's fed by every update().
+ * Events are active while their condition lasts, the callback is called once whenever an event is raised.
+ */
+class FlowAnomalyDetector {
+  public:
+    enum Event {
+        None = 0,
+        Leak = 1,                                // continuous flow above the leak flow rate
+        Burst = 2,                               // flow well above normal
+        Stuck = 4                                // no flow at all for too long
+    };
+
+    FlowAnomalyDetector();
+
+    void add(double flowrate, unsigned long duration);   // Adds a tick (flow rate in l/min, duration in ms).
+    void clear();                                         // Forgets all state, including what is normal.
+
+    FlowAnomalyDetector* setLeak(double flowrate, unsigned long duration);            // Flow above flowrate (in l/min) for duration (in ms) is a leak (0 disables).
+    FlowAnomalyDetector* setBurst(double allowance, double limit, double floor);      // CUSUM allowance and limit (in deviations), lowest deviation and use to learn from (in l/min).
+    FlowAnomalyDetector* setLearningRate(double alpha);                               // Weight of a tick in the normal mean and variance (0..1], also sets the warm-up.
+    FlowAnomalyDetector* setStuck(unsigned long duration);                            // No flow for duration (in ms) means the sensor is stuck (0 disables).
+    FlowAnomalyDetector* setCallback(void (*callback)(uint8_t event));               // Called with the event whenever one is raised.
+
+    uint8_t getEvents();                         // Returns the active events (a combination of Leak, Burst and Stuck).
+
+    unsigned long getFlowingDuration();          // Returns the time since the flow was last at or below the leak flow rate (in ms).
+    double getMinimumFlowrate();                 // Returns the lowest flow rate since then (in l/min).
+    bool isLearned();                            // Tells whether the warm-up is over (i.e. whether bursts can be raised).
+    unsigned long getIdleDuration();             // Returns the time since the last tick with flow (in ms).
+    double getBaseline();                        // Returns the baseline flow, e.g. a leak's (in l/min).
+    double getMean();                            // Returns the normal use (in l/min).
+    double getDeviation();                       // Returns the normal standard deviation of the use (in l/min, at least the floor).
+    double getCusum();                           // Returns the CUSUM statistic (in l/min).
+
+  protected:
+    void raise(uint8_t events);                  // Activates events and calls the callback for newly raised ones.
+
+    static unsigned long extend(unsigned long run, unsigned long duration);   // Extends a run length (saturating instead of wrapping around).
+
+    uint8_t _events = None;                      // active events
+
+    double _leakFlowrate = 0.0f;                 // flow rate that a leak stays above (in l/min)
+    unsigned long _leakDuration = 7200000;       // duration that makes a leak (in ms)
+    unsigned long _flowingDuration = 0;          // run length of flow above the leak flow rate (in ms)
+    double _minimumFlowrate = 0.0f;              // lowest flow rate of the run (in l/min)
+
+    double _allowance = 3.0f;                    // CUSUM allowance (in deviations)
+    double _limit = 5.0f;                        // CUSUM limit (in deviations)
+    double _floor = 1.0f;                        // lowest deviation, and lowest use to learn from (in l/min)
+    double _alpha = 1.0f / 8192;                 // weight of a tick in the normal mean and variance
+    uint16_t _warmup = 8192;                     // ticks of use to learn from before raising bursts (1/alpha)
+    uint16_t _learned = 0;                       // ticks of use learned from so far (up to the warm-up)
+    double _baseline = 0.0f;                     // baseline flow (in l/min)
+    double _mean = 0.0f;                         // normal use (in l/min)
+    double _variance = 0.0f;                     // normal variance of the use (in (l/min)^2)
+    double _cusum = 0.0f;                        // CUSUM statistic (in l/min)
+
+    unsigned long _stuckDuration = 86400000;     // duration without flow that means the sensor is stuck (in ms)
+    unsigned long _idleDuration = 0;             // run length of ticks without flow (in ms)
+
+    void (*_callback)(uint8_t event) = NULL;     // event callback
+};
+
+#endif   // _FLOWANOMALYDETECTOR_H_
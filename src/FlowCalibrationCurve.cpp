@@ -0,0 +1,108 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "FlowCalibrationCurve.h"                                           // https://github.com/sekdiy/FlowMeter
+
+FlowCalibrationCurve::FlowCalibrationCurve(const FlowSensorProperties &properties) {
+    double width = properties.capacity * properties.kFactor / 10.0f;       // width of a decile (in 1/s)
+
+    for (unsigned int decile = 0; decile < 10; decile++) {
+        this->addPoint((decile + 0.5f) * width, properties.mFactor[decile]);   // centre of the decile
+    }
+}
+
+FlowCalibrationCurve* FlowCalibrationCurve::addPoint(double frequency, double mFactor) {
+    if (this->_count >= maxPoints) {
+        return this;
+    }
+
+    uint8_t index = this->_count++;
+
+    while (index > 0 && this->_points[index - 1].frequency > frequency) {   // insertion sort, keeps points in order of frequency
+        this->_points[index] = this->_points[index - 1];
+        index--;
+    }
+
+    this->_points[index].frequency = frequency;
+    this->_points[index].mFactor = mFactor;
+
+    this->index();
+    return this;
+}
+
+FlowCalibrationCurve* FlowCalibrationCurve::clear() {
+    this->_count = 0;
+    this->index();
+    return this;
+}
+
+uint8_t FlowCalibrationCurve::getPointCount() const {
+    return this->_count;
+}
+
+FlowCalibrationPoint FlowCalibrationCurve::getPoint(uint8_t index) const {
+    return this->_points[index];
+}
+
+/**
+ * Interpolates piecewise-linearly between the two points around the given pulse rate.
+ *
+ * The cell of the pulse rate names a segment that starts below it (see index()). Only points within the same cell
+ * remain to be stepped past (none, unless points lie closer than a cell), so the cost doesn't grow with the number of points.
+ *
+ * @param frequency The pulse rate (in 1/s, not negative).
+ * @return The meter factor (constant beyond the outer points, 1 without points).
+ */
+double FlowCalibrationCurve::getMeterFactor(double frequency) const {
+    if (this->_count == 0) {
+        return 1.0f;                                                        // uncalibrated
+    }
+
+    if (frequency <= this->_points[0].frequency) {
+        return this->_points[0].mFactor;                                    // constant below the first point
+    }
+
+    if (frequency >= this->_points[this->_count - 1].frequency) {
+        return this->_points[this->_count - 1].mFactor;                     // constant above the last point
+    }
+
+    unsigned int cell = frequency * this->_cellScale;                       // below cellCount, except for rounding
+    uint8_t lower = this->_cells[cell < cellCount ? cell : cellCount - 1];
+
+    while (frequency >= this->_points[lower + 1].frequency) {               // points within the cell (the last point is above frequency)
+        lower++;
+    }
+
+    const FlowCalibrationPoint &below = this->_points[lower];
+    const FlowCalibrationPoint &above = this->_points[lower + 1];
+
+    return below.mFactor + (frequency - below.frequency) * (above.mFactor - below.mFactor) / (above.frequency - below.frequency);
+}
+
+/**
+ * Assigns every cell the last segment that starts in an earlier cell (or the first segment).
+ *
+ * A segment starts in an earlier cell if frequency * _cellScale < cell, i.e. with the very product getMeterFactor() truncates,
+ * so the segment noted for a cell starts strictly below any pulse rate in that cell, rounding included.
+ */
+void FlowCalibrationCurve::index() {
+    double last = this->_count > 0 ? this->_points[this->_count - 1].frequency : 0.0f;
+    this->_cellScale = last > 0.0f ? cellCount / last : 0.0f;
+
+    uint8_t lower = 0;
+
+    for (unsigned int cell = 0; cell < cellCount; cell++) {
+        while (lower + 2 < this->_count && this->_points[lower + 1].frequency * this->_cellScale < cell) {
+            lower++;                                                        // the next segment starts in an earlier cell
+        }
+
+        this->_cells[cell] = lower;
+    }
+}
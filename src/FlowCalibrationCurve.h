@@ -0,0 +1,64 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWCALIBRATIONCURVE_H_
+#define _FLOWCALIBRATIONCURVE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "FlowSensorProperties.h"
+
+/**
+ * FlowCalibrationPoint
+ *
+ * A single calibration point: the meter factor measured at a given pulse rate.
+ */
+typedef struct {
+  double frequency;                             // pulse rate (in 1/s)
+  double mFactor;                               // multiplicative correction factor near unity, "meter factor"
+} FlowCalibrationPoint;
+
+/**
+ * FlowCalibrationCurve
+ *
+ * A calibration curve with up to maxPoints points, interpolated piecewise-linearly (and held constant beyond the outer points).
+ *
+ * Sensor properties convert into a curve through the centres of their ten deciles.
+ * Adding a point also indexes the curve in cellCount uniform cells up to its last point: each cell notes the segment its
+ * lower end lies in, so a lookup takes one multiplication to find the cell, steps past the points within that cell (if any),
+ * and interpolates within the segment. Every point is thus reproduced exactly, however closely spaced, at a cost that doesn't
+ * grow with the number of points. A FlowMeter (with FLOWMETER_CURVES defined) refers to a curve rather than copying it.
+ */
+class FlowCalibrationCurve {
+  public:
+    static const uint8_t maxPoints = 16;         // maximum number of calibration points
+    static const uint8_t cellCount = 32;         // number of uniform cells of the segment index
+
+    FlowCalibrationCurve() {};
+    FlowCalibrationCurve(const FlowSensorProperties &properties);    // Converts the decile meter factors into a curve.
+
+    FlowCalibrationCurve* addPoint(double frequency, double mFactor); // Adds a calibration point (ignored if the curve is full).
+    FlowCalibrationCurve* clear();                                    // Removes all calibration points.
+
+    uint8_t getPointCount() const;                                    // Returns the number of calibration points.
+    FlowCalibrationPoint getPoint(uint8_t index) const;               // Returns a calibration point (in order of frequency).
+
+    double getMeterFactor(double frequency) const;                    // Interpolates the meter factor at a given pulse rate (1 without points).
+
+  protected:
+    void index();                                // Notes the segment at the lower end of every cell.
+
+    FlowCalibrationPoint _points[maxPoints];    // calibration points, sorted by frequency
+    uint8_t _count = 0;                          // number of calibration points
+    uint8_t _cells[cellCount] = {0};             // per cell: index of the point that starts its lowest segment
+    double _cellScale = 0.0f;                    // cells per (1/s), i.e. cellCount / frequency of the last point
+};
+
+#endif   // _FLOWCALIBRATIONCURVE_H_
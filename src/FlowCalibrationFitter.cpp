@@ -0,0 +1,143 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <math.h>
+#include "FlowCalibrationFitter.h"                                          // https://github.com/sekdiy/FlowMeter
+
+FlowCalibrationFitter::FlowCalibrationFitter(const FlowSensorProperties &properties) :
+    _properties(properties)
+{
+    this->clear();
+}
+
+/**
+ * Adds a reference run, in constant time.
+ *
+ * @param pulses The pulses counted during the run.
+ * @param duration The duration of the run (in ms), which gives its pulse rate and so its decile.
+ * @param volume The reference volume of the run (in l).
+ * @return Whether the run was added (runs without pulses, duration or volume are not).
+ */
+bool FlowCalibrationFitter::addRun(unsigned long pulses, unsigned long duration, double volume) {
+    if (pulses == 0 || duration == 0 || volume <= 0.0f) {
+        return false;
+    }
+
+    double frequency = pulses * 1000.0f / duration;                         // pulse rate (in 1/s), as update() normalises it
+    unsigned int decile = floor(10.0f * frequency / (this->_properties.capacity * this->_properties.kFactor));   // as FlowMeter::correction()
+    unsigned int ceiling = 9;                                               // beyond capacity counts as the top decile, as in FlowMeter
+
+    accumulate(this->_kFactor, pulses / volume, volume * volume);           // pulses = b * volume, b = sum(p * V) / sum(V^2)
+    accumulate(this->_deciles[decile < ceiling ? decile : ceiling], volume / pulses, (double) pulses * pulses);   // volume = c * pulses
+
+    return true;
+}
+
+void FlowCalibrationFitter::clear() {
+    Fit empty = {0, 0.0f, 0.0f, 0.0f};
+
+    this->_kFactor = empty;
+
+    for (uint8_t decile = 0; decile < 10; decile++) {
+        this->_deciles[decile] = empty;
+    }
+}
+
+double FlowCalibrationFitter::getKFactor() {
+    return this->_kFactor.runs > 0 ? this->_kFactor.mean / 60.0f : this->_properties.kFactor;
+}
+
+double FlowCalibrationFitter::getKFactorError() {
+    return error(this->_kFactor) / 60.0f;
+}
+
+/**
+ * Returns the meter factor of a decile, i.e. the one that makes update() reproduce the reference volumes with the fitted k-factor.
+ *
+ * Deciles without runs are interpolated linearly between the nearest deciles with runs (and held constant beyond the outermost ones).
+ */
+double FlowCalibrationFitter::getMeterFactor(uint8_t decile) {
+    double pulseRate = 60.0f * this->getKFactor();                          // pulses per litre
+
+    if (this->_deciles[decile].runs > 0) {
+        return pulseRate * this->_deciles[decile].mean;                     // V = p * m / (60 * K), see FlowMeter::update()
+    }
+
+    int below = decile - 1, above = decile + 1;
+
+    while (below >= 0 && this->_deciles[below].runs == 0) below--;
+    while (above <= 9 && this->_deciles[above].runs == 0) above++;
+
+    if (below < 0 && above > 9) {
+        return 1.0f;                                                        // no runs at all
+    }
+
+    if (below < 0) return pulseRate * this->_deciles[above].mean;
+    if (above > 9) return pulseRate * this->_deciles[below].mean;
+
+    double share = (double) (decile - below) / (above - below);
+    return pulseRate * (this->_deciles[below].mean + share * (this->_deciles[above].mean - this->_deciles[below].mean));
+}
+
+/**
+ * Returns the standard error of a decile's meter factor.
+ *
+ * It only reflects the scatter of the decile's runs, since the volume per pulse that update() applies in the decile
+ * doesn't depend on how it's split into k-factor and meter factor.
+ */
+double FlowCalibrationFitter::getMeterFactorError(uint8_t decile) {
+    return 60.0f * this->getKFactor() * error(this->_deciles[decile]);
+}
+
+unsigned int FlowCalibrationFitter::getRunCount() {
+    return this->_kFactor.runs;
+}
+
+unsigned int FlowCalibrationFitter::getRunCount(uint8_t decile) {
+    return this->_deciles[decile].runs;
+}
+
+/**
+ * Returns the fitted properties.
+ *
+ * The capacity is scaled with the k-factor, so that capacity * kFactor (the pulse rate at capacity, which sets the deciles in FlowMeter)
+ * stays that of the given properties, and a meter with the fitted properties picks the same decile for a pulse rate as the fit did.
+ */
+FlowSensorProperties FlowCalibrationFitter::getProperties() {
+    FlowSensorProperties properties = this->_properties;
+
+    properties.kFactor = this->getKFactor();
+    properties.capacity = this->_properties.capacity * this->_properties.kFactor / properties.kFactor;   // same pulse rate at capacity
+
+    for (uint8_t decile = 0; decile < 10; decile++) {
+        properties.mFactor[decile] = this->getMeterFactor(decile);
+    }
+
+    return properties;
+}
+
+void FlowCalibrationFitter::accumulate(Fit &fit, double value, double weight) {
+    double total = fit.weight + weight;
+    double difference = value - fit.mean;
+    double increment = difference * weight / total;
+
+    fit.runs++;
+    fit.weight = total;
+    fit.mean += increment;
+    fit.deviation += (total - weight) * difference * increment;            // West (1979), i.e. weight * difference * (value - new mean)
+}
+
+double FlowCalibrationFitter::error(const Fit &fit) {
+    if (fit.runs < 2) {
+        return NAN;
+    }
+
+    return sqrt(fit.deviation / (fit.runs - 1) / fit.weight);              // s / sqrt(sum of weights), with s^2 = residuals / (n - 1)
+}
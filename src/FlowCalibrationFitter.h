@@ -0,0 +1,69 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWCALIBRATIONFITTER_H_
+#define _FLOWCALIBRATIONFITTER_H_
+
+#include <stdint.h>
+#include "FlowSensorProperties.h"
+
+/**
+ * FlowCalibrationFitter
+ *
+ * Fits sensor properties to reference runs, one run at a time, e.g. on the device itself: run a known volume through the sensor
+ * (measured by a scale or a graduated vessel), then add the run's pulses, duration and reference volume.
+ *
+ * The k-factor is the least-squares fit of pulses = 60 * kFactor * volume over all runs. Each run falls into the decile of its
+ * pulse rate relative to capacity * kFactor of the given properties, as FlowMeter picks the decile of a tick (so runs near a
+ * decile boundary are fitted into the decile that the factor is later applied to), and a decile's meter factor is kFactor times
+ * the least-squares fit of volume = c * pulses over its runs
+ * (so that update() reproduces the reference volumes). Deciles without runs are interpolated between their neighbours.
+ *
+ * Both fits are kept as weighted running means and squared deviations (West's update, the weighted form of Welford's),
+ * so nothing but 11 small accumulators is stored, and the sums stay accurate in single precision (which is all the AVR has).
+ * Their residuals give the standard error of every factor, as a measure of confidence.
+ */
+class FlowCalibrationFitter {
+  public:
+    FlowCalibrationFitter(const FlowSensorProperties &properties);  // Starts a fit for a sensor (capacity * kFactor sets the deciles, its k-factor is kept until there are runs).
+
+    bool addRun(unsigned long pulses, unsigned long duration, double volume);   // Adds a reference run (duration in ms, volume in l), returns false if it's empty.
+    void clear();                                // Forgets all runs.
+
+    double getKFactor();                         // Returns the fitted k-factor (in (pulses/s) / (l/min)).
+    double getKFactorError();                    // Returns the standard error of the k-factor (NAN with fewer than two runs).
+    double getMeterFactor(uint8_t decile);       // Returns the fitted meter factor of a decile (interpolated if it has no runs).
+    double getMeterFactorError(uint8_t decile);  // Returns the standard error of a decile's meter factor (NAN with fewer than two runs in it).
+
+    unsigned int getRunCount();                  // Returns the number of runs.
+    unsigned int getRunCount(uint8_t decile);    // Returns the number of runs in a decile.
+
+    FlowSensorProperties getProperties();        // Returns the fitted properties (e.g. for FlowMeter::setProperties()), with the same deciles.
+
+  protected:
+    /**
+     * Weighted running mean and squared deviation of a ratio.
+     */
+    typedef struct {
+      unsigned int runs;                         // number of runs
+      double weight;                             // sum of weights
+      double mean;                               // weighted mean
+      double deviation;                          // weighted sum of squared deviations from the mean
+    } Fit;
+
+    static void accumulate(Fit &fit, double value, double weight);  // Adds a value with the given weight.
+    static double error(const Fit &fit);         // Returns the standard error of the mean (NAN with fewer than two runs).
+
+    FlowSensorProperties _properties;            // sensor properties (capacity and initial k-factor)
+    Fit _kFactor;                                // pulses per litre (i.e. 60 * kFactor), weighted by volume^2
+    Fit _deciles[10];                            // litres per pulse of each decile, weighted by pulses^2
+};
+
+#endif   // _FLOWCALIBRATIONFITTER_H_
@@ -0,0 +1,38 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWCHECKSUM_H_
+#define _FLOWCHECKSUM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * CRC-16/CCITT (polynomial 0x1021, initial value 0xffff), as used by totalizer records and telemetry frames.
+ *
+ * @param data The bytes to check.
+ * @param length The number of bytes.
+ * @return The checksum.
+ */
+inline uint16_t flowChecksum(const uint8_t *data, size_t length) {
+    uint16_t crc = 0xffff;
+
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t) data[i] << 8;
+
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+
+    return crc;
+}
+
+#endif   // _FLOWCHECKSUM_H_
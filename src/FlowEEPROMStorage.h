@@ -0,0 +1,44 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWEEPROMSTORAGE_H_
+#define _FLOWEEPROMSTORAGE_H_
+
+#include <EEPROM.h>
+#include "FlowStorage.h"
+
+/**
+ * FlowEEPROMStorage
+ *
+ * The on-chip EEPROM as storage for a FlowTotalizer (AVR and other cores with a byte-wise EEPROM library).
+ *
+ * Bytes are written with EEPROM.update(), so cells that already hold the right value aren't erased again.
+ * This header is separate (and header-only), so that sketches which don't persist their totals don't pull in the EEPROM library.
+ */
+class FlowEEPROMStorage : public FlowStorage {
+  public:
+    unsigned int size() {
+        return EEPROM.length();
+    }
+
+    void read(unsigned int address, uint8_t *data, unsigned int length) {
+        for (unsigned int i = 0; i < length; i++) {
+            data[i] = EEPROM.read(address + i);
+        }
+    }
+
+    void write(unsigned int address, const uint8_t *data, unsigned int length) {
+        for (unsigned int i = 0; i < length; i++) {
+            EEPROM.update(address + i, data[i]);                            // skip cells that don't change (saves wear and time)
+        }
+    }
+};
+
+#endif   // _FLOWEEPROMSTORAGE_H_
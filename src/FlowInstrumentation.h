@@ -0,0 +1,44 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWINSTRUMENTATION_H_
+#define _FLOWINSTRUMENTATION_H_
+
+/**
+ * Instrumentation is compiled in by defining FLOWMETER_INSTRUMENTATION for the whole build (e.g. build_flags = -D FLOWMETER_INSTRUMENTATION).
+ * Otherwise FLOWMETER_INSTRUMENT() discards its argument, so that the hot paths and the meter's RAM use stay exactly as they were.
+ */
+#if defined(FLOWMETER_INSTRUMENTATION)
+#define FLOWMETER_INSTRUMENT(statement) statement
+#else
+#define FLOWMETER_INSTRUMENT(statement)
+#endif
+
+/**
+ * FlowInstrumentation
+ *
+ * Counters that tell where a meter loses accuracy in the field: pulses lost to ISR contention (long count() calls or pulse intervals
+ * near the interrupt latency), late ticks, or flow beyond the sensor's capacity. All times are taken with micros().
+ */
+typedef struct {
+  unsigned long interrupts;                     // count() calls, i.e. interrupts (including pulses rejected by debouncing)
+  unsigned long countMicros;                    // total time spent in count() (in us)
+  unsigned long countMaxMicros;                 // longest count() call (in us)
+  unsigned long minInterval;                    // shortest interval between two count() calls (in us, (unsigned long) -1 before the second call)
+  unsigned long maxInterval;                    // longest interval between two count() calls (in us)
+
+  unsigned long updates;                        // update() calls
+  unsigned long updateMicros;                   // total time spent in update() (in us)
+  unsigned long updateMaxMicros;                // longest update() call (in us)
+  unsigned long overCapacity;                   // ticks whose pulse rate exceeded capacity * kFactor
+  unsigned long lateUpdates;                    // update() calls that came more than 10% later than their duration after the previous one
+} FlowInstrumentation;
+
+#endif   // _FLOWINSTRUMENTATION_H_
@@ -12,12 +12,32 @@
 #include "Arduino.h"
 #include "FlowMeter.h"                                                      // https://github.com/sekdiy/FlowMeter
 
+#if defined(FLOWMETER_TOTALIZER)
+/**
+ * Adds a value to a sum without losing the low-order bits of the value to the rounding of the sum (Kahan summation).
+ *
+ * Once a sum is large, a float (i.e. double on AVR) sum absorbs small increments partly or entirely.
+ * The compensation carries the lost bits over to the next addition, so the error stays at the level of a single rounding.
+ */
+static void accumulate(double &sum, double &compensation, double value) {
+    double term = value - compensation;
+    double total = sum + term;
+    compensation = (total - sum) - term;
+    sum = total;
+}
+#endif
+
 FlowMeter::FlowMeter(unsigned int pin, FlowSensorProperties prop, void (*callback)(void), uint8_t interruptMode) :
     _pin(pin),                                                              // store pin number
     _properties(prop),                                                      // store sensor properties
     _interruptCallback(callback),
-    _interruptMode(interruptMode)                                            
+    _interruptMode(interruptMode)
 {
+#if defined(FLOWMETER_TOTALIZER)
+    this->_pulseVolume = 1.0 / (60.0 * prop.kFactor);                      // V = p / K / 60, see update()
+#endif
+    FLOWMETER_INSTRUMENT(this->clearInstrumentation());
+
     pinMode(this->_pin, INPUT_PULLUP);                                      // initialize interrupt pin as input with pullup
 
     if (this->_interruptCallback != NULL) {                                 // if ISR callback has been provided, attach it
@@ -27,6 +47,14 @@ FlowMeter::FlowMeter(unsigned int pin, FlowSensorProperties prop, void (*callbac
     this->reset();                                                          // ignore pulses generated during initialisation
 }
 
+#if defined(FLOWMETER_CURVES)
+FlowMeter::FlowMeter(unsigned int pin, FlowSensorProperties prop, const FlowCalibrationCurve &curve, void (*callback)(void), uint8_t interruptMode) :
+    FlowMeter(pin, prop, callback, interruptMode)
+{
+    this->_curve = &curve;                                                  // refer to the curve (and its index)
+}
+#endif
+
 FlowMeter::~FlowMeter() {
     if (this->_interruptCallback != NULL) {                                 // if ISR callback has been provided, detach it
         detachInterrupt(digitalPinToInterrupt(this->_pin));
@@ -42,11 +70,30 @@ double FlowMeter::getCurrentVolume() {
 }
 
 double FlowMeter::getTotalFlowrate() {
-    return this->_totalVolume / (this->_totalDuration / 1000.0f) * 60.0f;   // in l/min
+    return this->getTotalVolume() / (this->_totalDuration / 1000.0f) * 60.0f;   // in l/min
 }
 
+/**
+ * With FLOWMETER_TOTALIZER, the total volume is derived from the pulse counts when asked for, rather than summed up tick by tick.
+ *
+ * Each decile has a single meter factor, so its pulses make up V = p * m / K / 60 (see update()) up to one rounding,
+ * and a tick costs one integer addition. Only with a calibration curve, where every tick has a meter factor of its own,
+ * do the deviations of the ticks from their nominal volume go through a (compensated) floating point sum.
+ *
+ * Without it, the volume of every tick is added to a plain sum, which (in float precision on AVR) absorbs small ticks after months.
+ */
 double FlowMeter::getTotalVolume() {
+#if defined(FLOWMETER_TOTALIZER)
+    double pulses = this->_totalPulses;                                     // with a curve, at nominal volume
+
+    for (unsigned int decile = 0; decile < 10; decile++) {
+        pulses += this->_decilePulses[decile] * this->_properties.mFactor[decile];
+    }
+
+    return pulses * this->_pulseVolume + (this->_volumeOffset - this->_volumeCompensation);   // in l
+#else
     return this->_totalVolume;                                              // in l
+#endif
 }
 
 /**
@@ -79,41 +126,132 @@ double FlowMeter::getTotalVolume() {
  */
 void FlowMeter::update(unsigned long duration) {
     /* sampling */
-    noInterrupts();                                                         // going to change interrupt variable(s)
-    volatile unsigned long pulses = this->_currentPulses;                   // sample current pulses from counter
-    this->_currentPulses = 0;                                               // reset pulse counter after successful sampling
-    interrupts();                                                           // done changing interrupt variable(s)
+    unsigned long pulses = this->sample();                                  // sample and reset current pulses
 
     /* normalisation */
     double seconds = duration / 1000.0f;                                    // normalised duration (in s, i.e. per 1000ms)
     double frequency = pulses / seconds;                                    // normalised frequency (in 1/s)
 
     /* determine current correction factor (from sensor properties) */
-    unsigned int decile = floor(10.0f * frequency / (this->_properties.capacity * this->_properties.kFactor));          // decile of current flow relative to sensor capacity
-    unsigned int ceiling =  9;                                                                                          // highest possible decile index
-    this->_currentCorrection = this->_properties.kFactor / this->_properties.mFactor[min(decile, ceiling)];             // combine constant k-factor and m-factor for decile
+    this->_currentCorrection = this->correction(frequency);
 
     /* update current calculations: */
     this->_currentFlowrate = frequency / this->_currentCorrection;          // get flow rate (in l/min) from normalised frequency and combined correction factor
     this->_currentVolume = this->_currentFlowrate / (60.0f/seconds);        // get volume (in l) from normalised flow rate and normalised time
 
     /* update statistics: */
+    this->record(duration, frequency);
+}
+
+double FlowMeter::correction(double frequency) {
+#if defined(FLOWMETER_CURVES)
+    if (this->curved()) {                                                                                               // calibration curve
+        return this->_properties.kFactor / this->_curve->getMeterFactor(frequency);                                     // interpolate within the segment around frequency
+    }
+#endif
+
+    unsigned int decile = floor(10.0f * frequency / (this->_properties.capacity * this->_properties.kFactor));          // decile of current flow relative to sensor capacity
+    unsigned int ceiling =  9;                                                                                          // highest possible decile index
+    decile = min(decile, ceiling);
+#if defined(FLOWMETER_TOTALIZER)
+    this->_currentDecile = decile;                                                                                      // (for record())
+#endif
+    return this->_properties.kFactor / this->_properties.mFactor[decile];                                               // combine constant k-factor and m-factor for decile
+}
+
+unsigned long FlowMeter::sample() {
+    FLOWMETER_INSTRUMENT(unsigned long now = micros());
+    FLOWMETER_INSTRUMENT(this->_updateInterval = now - this->_updateMicros);
+    FLOWMETER_INSTRUMENT(this->_updateMicros = now);
+
+    unsigned long count = this->_source != NULL ?
+        this->_source->read() :                                             // sample external pulse source
+        this->_pulses.read();                                               // sample pulse counter (without disabling interrupts)
+    unsigned long pulses = count - this->_sampledPulses;                    // pulses since the last sample (wrap-around safe)
+    this->_sampledPulses = count;
+    this->_currentPulses = pulses;
+
+#if defined(FLOWMETER_TARGETS)
+    if (this->_source != NULL && this->_target.countDown(pulses)) {         // count() doesn't run with a pulse source, so check targets per tick
+        this->_target.reach();
+    }
+#endif
+
+    return pulses;
+}
+
+void FlowMeter::record(unsigned long duration, double frequency) {
     this->_currentDuration = duration;                                      // store current update duration (convenience, in ms)
     this->_currentFrequency = frequency;                                    // store current pulses per second (convenience, in 1/s)
     this->_totalDuration += duration;                                       // accumulate total duration (in ms)
+
+#if defined(FLOWMETER_TOTALIZER)
+    if (!this->curved()) {
+        this->_decilePulses[this->_currentDecile] += this->_currentPulses;  // accumulate pulses per decile (the total volume is derived from these)
+    } else {
+        this->_totalPulses += this->_currentPulses;
+        accumulate(this->_volumeOffset, this->_volumeCompensation, this->_currentVolume - this->_currentPulses * this->_pulseVolume);   // deviation from nominal volume (in l)
+    }
+
+    accumulate(this->_totalCorrection, this->_correctionCompensation, this->_currentCorrection * duration);                        // accumulate corrections over time
+#else
     this->_totalVolume += this->_currentVolume;                             // accumulate total volume (in l)
     this->_totalCorrection += this->_currentCorrection * duration;          // accumulate corrections over time
+#endif
+
+#if defined(FLOWMETER_HOOKS)
+    if (this->_statistics != NULL) {
+        this->_statistics->add(this->_currentFlowrate);                     // feed rolling statistics (in l/min)
+    }
+
+    if (this->_detector != NULL) {
+        this->_detector->add(this->_currentFlowrate, duration);             // feed anomaly detection (in l/min and ms)
+    }
+#endif
+
+    FLOWMETER_INSTRUMENT(this->instrumentUpdate(duration, frequency));
 }
 
 void FlowMeter::count() {
-    this->_currentPulses++;                                                 // this should be called from an interrupt service routine
+    FLOWMETER_INSTRUMENT(unsigned long entry = micros());
+
+    if (this->_debounceInterval == 0 || !this->reject(micros())) {          // not a spurious edge
+        this->accept();
+    }
+
+    FLOWMETER_INSTRUMENT(this->instrumentCount(entry));
+}
+
+/**
+ * Rejects a pulse that follows the previous accepted one sooner than the sensor can produce pulses.
+ *
+ * Costs one subtraction and compare (wrap-around safe). Rejected pulses don't restart the interval,
+ * so a burst of ringing after an edge is rejected as a whole.
+ */
+bool FlowMeter::reject(unsigned long now) {
+    if (now - this->_debouncedMicros < this->_debounceInterval) {
+        this->_rejected.increment();
+        return true;
+    }
+
+    this->_debouncedMicros = now;
+    return false;
+}
+
+void FlowMeter::accept() {
+    this->_pulses.increment();                                              // this should be called from an interrupt service routine
+
+#if defined(FLOWMETER_TARGETS)
+    if (this->_target.countDown()) {                                        // volume target reached with this very pulse
+        this->_target.reach();
+    }
+#endif
 }
 
 void FlowMeter::reset() {
-    noInterrupts();                                                         // going to change interrupt variable(s)
-    this->_currentPulses = 0;                                               // reset pulse counter
-    interrupts();                                                           // done changing interrupt variable(s)
+    this->_sampledPulses = this->_source != NULL ? this->_source->read() : this->_pulses.read();   // skip pulses counted so far
 
+    this->_currentPulses = 0;
     this->_currentFrequency = 0.0f;
     this->_currentDuration = 0.0f;
     this->_currentFlowrate = 0.0f;
@@ -125,6 +263,12 @@ unsigned int FlowMeter::getPin() {
     return this->_pin;
 }
 
+FlowMeter* FlowMeter::setPulseSource(FlowPulseSource *source) {
+    this->_source = source;
+    this->_sampledPulses = source != NULL ? source->read() : this->_pulses.read();   // start counting from now
+    return this;
+}
+
 unsigned long FlowMeter::getCurrentDuration() {
     return this->_currentDuration;                                          // in ms
 }
@@ -144,24 +288,237 @@ unsigned long FlowMeter::getTotalDuration() {
     return this->_totalDuration;                                            // in ms
 }
 
+uint64_t FlowMeter::getTotalDuration64() {
+    return this->_totalDuration;                                            // in ms
+}
+
+#if defined(FLOWMETER_TOTALIZER)
+uint64_t FlowMeter::getTotalPulses() {
+    uint64_t pulses = this->_totalPulses;
+
+    for (unsigned int decile = 0; decile < 10; decile++) {
+        pulses += this->_decilePulses[decile];
+    }
+
+    return pulses;
+}
+#endif
+
 double FlowMeter::getTotalError() {
     // average error (in %) = average error * 100
     // average error = average correction rate - 1
     // average correction rate = k-factor / corrections over time * total time
-    return (this->_properties.kFactor / this->_totalCorrection * this->_totalDuration - 1) * 100;
+    return (this->_properties.kFactor / this->getTotalCorrection() * this->_totalDuration - 1) * 100;
+}
+
+double FlowMeter::getTotalCorrection() {
+#if defined(FLOWMETER_TOTALIZER)
+    return this->_totalCorrection - this->_correctionCompensation;
+#else
+    return this->_totalCorrection;
+#endif
 }
 
-FlowMeter* FlowMeter::setTotalDuration(unsigned long totalDuration) {
+FlowMeter* FlowMeter::setTotalDuration(uint64_t totalDuration) {
     this->_totalDuration = totalDuration;
     return this;
 }
 
 FlowMeter* FlowMeter::setTotalVolume(double totalVolume) {
+#if defined(FLOWMETER_TOTALIZER)
+    this->_totalPulses = 0;                                                 // the pulses behind the given volume are unknown
+
+    for (unsigned int decile = 0; decile < 10; decile++) {
+        this->_decilePulses[decile] = 0;
+    }
+
+    this->_volumeOffset = totalVolume;
+    this->_volumeCompensation = 0.0f;
+#else
     this->_totalVolume = totalVolume;
+#endif
     return this;
 }
 
 FlowMeter* FlowMeter::setTotalCorrection(double totalCorrection) {
     this->_totalCorrection = totalCorrection;
+#if defined(FLOWMETER_TOTALIZER)
+    this->_correctionCompensation = 0.0f;
+#endif
+    return this;
+}
+
+/**
+ * Switches to new sensor properties while running, e.g. to apply a calibration fitted on the device (see FlowCalibrationFitter).
+ *
+ * The total volume measured so far is kept as it is (and getTotalPulses() restarts), a calibration curve is replaced by
+ * the new decile meter factors. A debounce interval derived from the old properties is kept, call setDebounce() again if it should follow.
+ *
+ * @param properties The new sensor properties.
+ */
+FlowMeter* FlowMeter::setProperties(const FlowSensorProperties &properties) {
+    double totalVolume = this->getTotalVolume();                            // measured with the old properties
+
+    this->_properties = properties;
+#if defined(FLOWMETER_TOTALIZER)
+    this->_pulseVolume = 1.0 / (60.0 * properties.kFactor);                // V = p / K / 60, see update()
+#endif
+#if defined(FLOWMETER_CURVES)
+    this->_curve = NULL;                                                    // correct per decile from now on
+#endif
+
+    return this->setTotalVolume(totalVolume);
+}
+
+FlowSensorProperties FlowMeter::getProperties() {
+    return this->_properties;
+}
+
+#if defined(FLOWMETER_TARGETS)
+/**
+ * Arms a volume target, e.g. to close a valve after a dose.
+ *
+ * The volume is converted into a number of pulses once, with the correction factor of the current tick
+ * (or of half the sensor's capacity if there is no flow yet). From then on, count() only counts down and compares,
+ * and calls the callback with the very pulse that completes the volume (so the overshoot is below one pulse).
+ * With a pulse source instead of count(), the target is checked in update(), i.e. once per tick.
+ *
+ * @param volume The volume to measure from now on (in l).
+ * @param callback Called once the target is reached (from count(), i.e. in interrupt context, so keep it short).
+ */
+FlowMeter* FlowMeter::setTarget(double volume, void (*callback)(void)) {
+    double correction = this->_currentCorrection > 0.0f ?
+        this->_currentCorrection :
+        this->correction(this->_properties.capacity * this->_properties.kFactor / 2.0f);   // idle: assume mid-range flow
+    double pulses = volume * 60.0f * correction;                            // V = p / (60 * correction), see update()
+    unsigned long threshold = pulses > 0.5f ? (unsigned long) (pulses + 0.5f) : 0;
+
+    noInterrupts();                                                         // count() reads the target
+    this->_target.arm(threshold, callback);
+    interrupts();
+
+    if (threshold == 0) {
+        this->_target.reach();                                              // nothing to wait for
+    }
+
     return this;
 }
+
+FlowMeter* FlowMeter::clearTarget() {
+    noInterrupts();
+    this->_target.arm(0, NULL);
+    interrupts();
+
+    return this;
+}
+
+bool FlowMeter::isTargetReached() {
+    return this->_target.isReached();
+}
+
+unsigned long FlowMeter::getTargetPulses() {
+    noInterrupts();
+    unsigned long pulses = this->_target.getPulses();
+    interrupts();
+
+    return pulses;
+}
+#endif
+
+/**
+ * Rejects pulses that come faster than the sensor can produce them, i.e. faster than its capacity (plus a margin for jitter) allows.
+ *
+ * @param margin The share by which the pulse rate may exceed capacity * kFactor (e.g. 0.5 accepts up to 150 % of capacity).
+ */
+FlowMeter* FlowMeter::setDebounce(double margin) {
+    double rate = this->_properties.capacity * this->_properties.kFactor * (1.0f + margin);   // highest accepted pulse rate (in 1/s)
+    return this->setDebounceInterval(rate > 0.0f ? 1e6 / rate : 0);
+}
+
+FlowMeter* FlowMeter::setDebounceInterval(unsigned long interval) {
+    noInterrupts();                                                         // count() reads both
+    this->_debounceInterval = interval;
+    this->_debouncedMicros = micros() - interval;                           // accept the next pulse in any case
+    interrupts();
+
+    return this;
+}
+
+unsigned long FlowMeter::getDebounceInterval() {
+    return this->_debounceInterval;
+}
+
+unsigned long FlowMeter::getRejectedPulses() {
+    return this->_rejected.read();
+}
+
+#if defined(FLOWMETER_HOOKS)
+FlowMeter* FlowMeter::setStatistics(FlowStatisticsBase *statistics) {
+    this->_statistics = statistics;
+    return this;
+}
+
+FlowStatisticsBase* FlowMeter::getStatistics() {
+    return this->_statistics;
+}
+
+FlowMeter* FlowMeter::setDetector(FlowAnomalyDetector *detector) {
+    this->_detector = detector;
+    return this;
+}
+
+FlowAnomalyDetector* FlowMeter::getDetector() {
+    return this->_detector;
+}
+#endif
+
+#if defined(FLOWMETER_INSTRUMENTATION)
+FlowInstrumentation FlowMeter::getInstrumentation() {
+    noInterrupts();                                                         // count() updates several counters
+    FlowInstrumentation instrumentation = this->_instrumentation;
+    interrupts();
+
+    return instrumentation;
+}
+
+FlowMeter* FlowMeter::clearInstrumentation() {
+    noInterrupts();
+    this->_instrumentation = FlowInstrumentation();
+    this->_instrumentation.minInterval = (unsigned long) -1;
+    this->_updateMicros = micros();
+    interrupts();
+
+    return this;
+}
+
+void FlowMeter::instrumentCount(unsigned long entry) {
+    unsigned long cost = micros() - entry;
+
+    if (this->_instrumentation.interrupts > 0) {                            // interval to the previous pulse
+        unsigned long interval = entry - this->_lastPulseMicros;
+        this->_instrumentation.minInterval = min(this->_instrumentation.minInterval, interval);
+        this->_instrumentation.maxInterval = max(this->_instrumentation.maxInterval, interval);
+    }
+
+    this->_lastPulseMicros = entry;
+    this->_instrumentation.interrupts++;
+    this->_instrumentation.countMicros += cost;
+    this->_instrumentation.countMaxMicros = max(this->_instrumentation.countMaxMicros, cost);
+}
+
+void FlowMeter::instrumentUpdate(unsigned long duration, double frequency) {
+    unsigned long cost = micros() - this->_updateMicros;
+
+    if (this->_updateInterval / 1000 > duration + duration / 10) {          // more than 10% late
+        this->_instrumentation.lateUpdates++;
+    }
+
+    if (frequency > this->_properties.capacity * this->_properties.kFactor) {
+        this->_instrumentation.overCapacity++;
+    }
+
+    this->_instrumentation.updates++;
+    this->_instrumentation.updateMicros += cost;
+    this->_instrumentation.updateMaxMicros = max(this->_instrumentation.updateMaxMicros, cost);
+}
+#endif
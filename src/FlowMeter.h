@@ -12,10 +12,26 @@
 #define _FLOWMETER_H_
 
 #include "FlowSensorProperties.h"
+#include "FlowPulseCounter.h"
+#include "FlowPulseSource.h"
+#include "FlowTarget.h"
 #include "FlowSensorCalibration.h"
+#include "FlowCalibrationCurve.h"
+#include "FlowStatistics.h"
+#include "FlowAnomalyDetector.h"
+#include "FlowInstrumentation.h"
 
 /**
  * FlowMeter
+ *
+ * The base meter only keeps what update() needs, plus plain sums for the totals. The optional parts are compiled in
+ * by defining their flag for the whole build (e.g. `build_flags = -D FLOWMETER_TOTALIZER`), like FLOWMETER_INSTRUMENTATION;
+ * without the flag, a part takes no RAM and no time in count() or update():
+ *
+ * FLOWMETER_TOTALIZER: totals derived from 64-bit pulse counts per decile (see getTotalVolume()), and getTotalPulses().
+ * FLOWMETER_CURVES:    correction along a calibration curve (see FlowCalibrationCurve).
+ * FLOWMETER_TARGETS:   volume targets (see setTarget()).
+ * FLOWMETER_HOOKS:     rolling statistics and anomaly detection fed by update() (see setStatistics() and setDetector()).
  */
 class FlowMeter {
   public:
@@ -27,6 +43,19 @@ class FlowMeter {
      * @param callback The interrupt callback handler
      */
     FlowMeter(unsigned int pin = 2, FlowSensorProperties prop = UncalibratedSensor, void (*callback)(void) = NULL, uint8_t interruptMode = RISING);
+
+#if defined(FLOWMETER_CURVES)
+    /**
+     * Initializes a new flow meter object that corrects along a calibration curve instead of per decile.
+     *
+     * @param pin  The pin that the flow sensor is connected to (has to be interrupt capable).
+     * @param prop The properties of the actual flow sensor being used (capacity and k-factor, the meter factors are taken from the curve).
+     * @param curve The calibration curve (not copied, so it has to outlive the flow meter; without points, prop's deciles apply).
+     * @param callback The interrupt callback handler
+     */
+    FlowMeter(unsigned int pin, FlowSensorProperties prop, const FlowCalibrationCurve &curve, void (*callback)(void) = NULL, uint8_t interruptMode = RISING);
+    FlowMeter(unsigned int pin, FlowSensorProperties prop, const FlowCalibrationCurve &&curve, void (*callback)(void) = NULL, uint8_t interruptMode = RISING) = delete;   // (a temporary curve wouldn't outlive it)
+#endif
     ~FlowMeter();                                // Cleans up a flow meter object.
 
     double getCurrentFlowrate();                 // Returns the current flow rate since last tick (in l/min).
@@ -49,8 +78,8 @@ class FlowMeter {
      * setters enabling continued metering across power cycles
      */ 
 
-    FlowMeter* setTotalDuration(unsigned long totalDuration); // Sets the total (overall) duration (i.e. after power up).
-    FlowMeter* setTotalVolume(double totalVolume);            // Sets the total (overall) volume (i.e. after power up).
+    FlowMeter* setTotalDuration(uint64_t totalDuration);      // Sets the total (overall) duration (i.e. after power up).
+    FlowMeter* setTotalVolume(double totalVolume);            // Sets the total (overall) volume (i.e. after power up), restarts getTotalPulses() (if any).
     FlowMeter* setTotalCorrection(double totalCorrection);    // Sets the total (overall) correction factor (i.e. after power up).
 
     /*
@@ -59,16 +88,90 @@ class FlowMeter {
 
     unsigned int getPin();                       // Returns the Arduino pin number that the flow sensor is connected to.
 
+    FlowMeter* setPulseSource(FlowPulseSource *source);   // Reads pulses from the given source instead of counting them in count() (NULL to count again).
+    FlowMeter* setProperties(const FlowSensorProperties &properties);  // Switches to new sensor properties (e.g. a fresh calibration), keeping the totals.
+    FlowSensorProperties getProperties();                              // Returns the sensor properties in use.
+
     unsigned long getCurrentDuration();          // Returns the duration of the current tick (in ms).
     double getCurrentFrequency();                // Returns the pulse rate in the current tick (in 1/s).
     double getCurrentError();                    // Returns the error resulting from the current measurement (in %).
 
-    unsigned long getTotalDuration();            // Returns the total run time of this flow meter instance (in ms).
+    unsigned long getTotalDuration();            // Returns the total run time of this flow meter instance (in ms, wraps around after 49.7 days on the Arduino).
+    uint64_t getTotalDuration64();               // Returns the total run time of this flow meter instance (in ms, without wrapping around).
+#if defined(FLOWMETER_TOTALIZER)
+    uint64_t getTotalPulses();                   // Returns the pulses counted since the total volume was (re)set.
+#endif
     double getTotalError();                      // Returns the (linear) average error of this flow meter instance (in %).
+    double getTotalCorrection();                 // Returns the accumulated correction factors (i.e. for saving them with the totals).
+
+#if defined(FLOWMETER_TARGETS)
+    /*
+     * volume targets (e.g. for dosing, only with FLOWMETER_TARGETS defined)
+     */
+
+    FlowMeter* setTarget(double volume, void (*callback)(void) = NULL);  // Arms a target: the given volume (in l) from now on, callback is called by count() once it has flown.
+    FlowMeter* clearTarget();                                            // Disarms the target.
+    bool isTargetReached();                                              // Tells whether the armed target has been reached.
+    unsigned long getTargetPulses();                                     // Returns the pulses still missing to reach the target.
+#endif
+
+    /*
+     * debouncing (rejects spurious edges, e.g. from noise on long sensor cables)
+     */
+
+    FlowMeter* setDebounce(double margin = 0.5);             // Rejects pulses faster than the sensor's capacity * kFactor * (1 + margin).
+    FlowMeter* setDebounceInterval(unsigned long interval);  // Rejects pulses closer than interval (in us) to the previous accepted one (0 to stop).
+    unsigned long getDebounceInterval();                     // Returns the shortest accepted interval between two pulses (in us, 0: off).
+    unsigned long getRejectedPulses();                       // Returns the number of pulses rejected so far.
+
+#if defined(FLOWMETER_HOOKS)
+    /*
+     * rolling statistics over recent ticks (only with FLOWMETER_HOOKS defined)
+     */
+
+    FlowMeter* setStatistics(FlowStatisticsBase *statistics); // Feeds the flow rate of every tick into the given statistics window (NULL to stop).
+    FlowStatisticsBase* getStatistics();                       // Returns the statistics window (if any).
+
+    /*
+     * leak, burst and stuck sensor detection (only with FLOWMETER_HOOKS defined)
+     */
+
+    FlowMeter* setDetector(FlowAnomalyDetector *detector);     // Feeds every tick into the given anomaly detector (NULL to stop).
+    FlowAnomalyDetector* getDetector();                        // Returns the anomaly detector (if any).
+#endif
+
+#if defined(FLOWMETER_INSTRUMENTATION)
+    /*
+     * instrumentation (only with FLOWMETER_INSTRUMENTATION defined)
+     */
+
+    FlowInstrumentation getInstrumentation();    // Returns a consistent copy of the instrumentation counters.
+    FlowMeter* clearInstrumentation();           // Restarts the instrumentation counters.
+#endif
 
   protected:
+    unsigned long sample();                      // Fetches and clears the pulse counter of the current tick.
+    double correction(double frequency);         // Returns the combined correction factor for the given pulse rate (and notes its decile).
+    void record(unsigned long duration, double frequency);  // Stores the current tick and accumulates the totals.
+    bool curved() {                              // Tells whether a calibration curve with points applies.
+#if defined(FLOWMETER_CURVES)
+        return this->_curve != NULL && this->_curve->getPointCount() > 0;
+#else
+        return false;
+#endif
+    }
+    bool reject(unsigned long now);              // Tells whether a pulse at the given time (in us) is too close to the previous one, counts it if so.
+    void accept();                               // Counts a pulse (after debouncing).
+#if defined(FLOWMETER_INSTRUMENTATION)
+    void instrumentCount(unsigned long entry);   // Accounts for a count() call that started at the given time (in us).
+    void instrumentUpdate(unsigned long duration, double frequency);  // Accounts for the update() call that started in sample().
+#endif
+
     unsigned int _pin;                           // connection pin (has to be interrupt capable!)
     FlowSensorProperties _properties;            // sensor properties (including calibration data)
+#if defined(FLOWMETER_CURVES)
+    const FlowCalibrationCurve *_curve = NULL;   // calibration curve (not owned, meter factors if it has points)
+#endif
     void (*_interruptCallback)(void);            // interrupt callback
     uint8_t _interruptMode;                      // interrupt mode (LOW, CHANGE, RISING, FALLING, HIGH)
 
@@ -78,11 +181,44 @@ class FlowMeter {
     double _currentVolume = 0.0f;                // current volume (in l), e.g.: 1 l = 1 (l / min) / (60 * s)
     double _currentCorrection;                   // currently applied correction factor
 
-    unsigned long _totalDuration = 0.0f;         // total measured duration since begin of measurement (in ms)
+    uint64_t _totalDuration = 0;                 // total measured duration since begin of measurement (in ms)
+#if defined(FLOWMETER_TOTALIZER)
+    uint64_t _decilePulses[10] = {0};            // pulses per decile since the total volume was set (the total volume is derived from these)
+    uint64_t _totalPulses = 0;                   // pulses since the total volume was set, with a calibration curve
+    uint8_t _currentDecile = 0;                  // decile of the current correction factor
+    double _pulseVolume;                         // nominal volume of a pulse, i.e. without meter factor (in l)
+    double _volumeOffset = 0.0f;                 // total volume as set, plus the deviations of all curve ticks from their nominal volume (in l)
+    double _volumeCompensation = 0.0f;           // lost low-order bits of the volume offset (Kahan summation)
+    double _totalCorrection = 0.0f;              // accumulated correction factors
+    double _correctionCompensation = 0.0f;       // lost low-order bits of the accumulated correction factors (Kahan summation)
+#else
     double _totalVolume = 0.0f;                  // total volume since begin of measurement (in l)
     double _totalCorrection = 0.0f;              // accumulated correction factors
-
-    volatile unsigned long _currentPulses = 0;   // pulses within current sample period
+#endif
+
+    FlowPulseCounter _pulses;                    // pulses since construction (written by count())
+    FlowPulseSource *_source = NULL;             // external pulse source (not owned, replaces _pulses if set)
+    FlowPulseCounter _rejected;                  // pulses rejected by debouncing (written by count())
+    unsigned long _debounceInterval = 0;         // shortest accepted interval between two pulses (in us, 0: off)
+    unsigned long _debouncedMicros = 0;          // time of the previous accepted pulse (in us, written by count())
+    unsigned long _sampledPulses = 0;            // pulse counter at the end of the previous sample period
+    unsigned long _currentPulses = 0;            // pulses of the current tick
+
+#if defined(FLOWMETER_HOOKS)
+    FlowStatisticsBase *_statistics = NULL;      // rolling statistics (not owned, fed by record())
+    FlowAnomalyDetector *_detector = NULL;       // anomaly detector (not owned, fed by record())
+#endif
+
+#if defined(FLOWMETER_TARGETS)
+    FlowTarget _target;                          // volume target (counted down by count())
+#endif
+
+#if defined(FLOWMETER_INSTRUMENTATION)
+    FlowInstrumentation _instrumentation;        // instrumentation counters
+    unsigned long _lastPulseMicros;              // time of the previous pulse (in us, written by count())
+    unsigned long _updateMicros;                 // time the current update() started (in us)
+    unsigned long _updateInterval;               // time since the previous update() started (in us)
+#endif
 };
 
 #endif   // _FLOWMETER_H_
@@ -0,0 +1,340 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWMETERBANK_H_
+#define _FLOWMETERBANK_H_
+
+#include "Arduino.h"
+#include "FlowSensorProperties.h"
+#include "FlowPulseCounter.h"
+
+template <class Bank, uint8_t Channel, uint8_t Channels> struct FlowMeterBankTrampoline;
+
+/**
+ * FlowMeterBank
+ *
+ * Manages several flow sensors at once, e.g.: FlowMeterBank<8> Bank; Bank.attach(0, 2, FS400A);
+ *
+ * Every channel gets its own interrupt service routine, generated at compile time, so there are no callbacks to write.
+ * The channel state is kept as a structure of arrays: update() samples all pulse counters in one pass,
+ * then runs the correction for all channels in one tight loop. Current values are derived from the sampled pulses
+ * on demand, and all channels share one tick duration, which keeps the per-channel RAM small.
+ * A channel's totals (volume, duration and with them the averages) only accrue while it is attached, so a channel attached
+ * later reports its own run time rather than the bank's.
+ *
+ * The sensor properties are referenced, not copied, so they need to outlive the bank (as the shipped presets do).
+ * Channel indices beyond Channels - 1 are ignored (the setters return the bank all the same, so that chained calls go on,
+ * the getters return 0, getPin() returns 0xff and isAttached() false).
+ * The Id parameter tells apart banks of the same size (every bank type can have one instance).
+ */
+template <uint8_t Channels, uint8_t Id = 0>
+class FlowMeterBank {
+  public:
+    FlowMeterBank();                             // Initializes all channels for an uncalibrated sensor, without attaching them.
+    ~FlowMeterBank();                            // Detaches all attached channels.
+
+    /**
+     * Connects a flow sensor to a channel and attaches the channel's interrupt service routine.
+     *
+     * @param channel The channel index (0 to Channels - 1).
+     * @param pin  The pin that the flow sensor is connected to (has to be interrupt capable).
+     * @param prop The properties of the actual flow sensor being used (referenced, not copied).
+     * @param interruptMode The interrupt mode (LOW, CHANGE, RISING, FALLING, HIGH).
+     * @return The bank (check isAttached() to tell whether the channel exists).
+     */
+    FlowMeterBank* attach(uint8_t channel, uint8_t pin, const FlowSensorProperties &prop = UncalibratedSensor, uint8_t interruptMode = RISING);
+    FlowMeterBank* detach(uint8_t channel);      // Detaches the interrupt service routine of a channel.
+
+    void update(unsigned long duration = 1000);  // Updates all channels at the end of a measurement period.
+    void count(uint8_t channel);                 // Increments the pulse counter of a channel (if you'd rather provide your own interrupt service routines).
+    void reset();                                // Prepares all channels for a fresh measurement. Resets all current values, but not the totals.
+
+    double getCurrentFlowrate(uint8_t channel);  // Returns the current flow rate since last tick (in l/min).
+    double getCurrentVolume(uint8_t channel);    // Returns the current volume since last tick (in l).
+    double getCurrentFrequency(uint8_t channel); // Returns the pulse rate in the current tick (in 1/s).
+    double getCurrentError(uint8_t channel);     // Returns the error resulting from the current measurement (in %).
+
+    double getTotalFlowrate(uint8_t channel);    // Returns the (linear) average flow rate of a channel (in l/min).
+    double getTotalVolume(uint8_t channel);      // Returns the total volume flown trough a channel (in l).
+    double getTotalError(uint8_t channel);       // Returns the (linear) average error of a channel (in %).
+
+    unsigned long getCurrentDuration();          // Returns the duration of the current tick (in ms).
+    unsigned long getTotalDuration();            // Returns the total run time of the bank (in ms).
+    unsigned long getTotalDuration(uint8_t channel);   // Returns the total time a channel has been attached (in ms).
+    uint8_t getPin(uint8_t channel);             // Returns the Arduino pin number that a channel is connected to.
+    bool isAttached(uint8_t channel);            // Tells whether a channel exists and is attached.
+
+    FlowMeterBank* setTotalDuration(unsigned long totalDuration);                 // Sets the total (overall) duration of the bank and all channels (i.e. after power up).
+    FlowMeterBank* setTotalDuration(uint8_t channel, unsigned long totalDuration);   // Sets the total (overall) duration of a channel (i.e. after power up).
+    FlowMeterBank* setTotalVolume(uint8_t channel, double totalVolume);           // Sets the total (overall) volume of a channel (i.e. after power up).
+    FlowMeterBank* setTotalCorrection(uint8_t channel, double totalCorrection);   // Sets the total (overall) correction factor of a channel (i.e. after power up).
+
+  protected:
+    template <class Bank, uint8_t Channel, uint8_t Count> friend struct FlowMeterBankTrampoline;
+
+    template <uint8_t Channel>
+    static void isr() {                          // generated interrupt service routine of a channel
+        _instance->_pulses[Channel].increment();
+    }
+
+    static FlowMeterBank *_instance;             // target of the generated interrupt service routines
+
+    FlowPulseCounter _pulses[Channels];          // pulses since construction (written by the interrupt service routines)
+    unsigned long _sampledPulses[Channels];      // pulse counter at the end of the previous sample period
+    unsigned long _currentPulses[Channels];      // pulses within the current tick
+    uint8_t _currentDecile[Channels];            // decile of flow within the current tick
+    uint8_t _pins[Channels];                     // connection pins (0xff: not attached)
+    const FlowSensorProperties *_properties[Channels];  // sensor properties (including calibration data)
+    double _decileScale[Channels];               // deciles per (1/s), i.e. 10 / (capacity * k-factor)
+    double _totalVolume[Channels];               // total volume since begin of measurement (in l)
+    double _totalCorrection[Channels];           // accumulated correction factors
+    unsigned long _channelDuration[Channels];    // total duration each channel has been attached (in ms)
+
+    unsigned long _currentDuration = 0;          // current tick duration (in ms)
+    unsigned long _totalDuration = 0;            // total measured duration since begin of measurement (in ms)
+};
+
+/**
+ * Resolves a channel index to its generated interrupt service routine (instantiating exactly one per channel).
+ */
+template <class Bank, uint8_t Channel, uint8_t Channels>
+struct FlowMeterBankTrampoline {
+    static void (*get(uint8_t channel))(void) {
+        return channel == Channel ? &Bank::template isr<Channel> : FlowMeterBankTrampoline<Bank, Channel + 1, Channels>::get(channel);
+    }
+};
+
+template <class Bank, uint8_t Channels>
+struct FlowMeterBankTrampoline<Bank, Channels, Channels> {
+    static void (*get(uint8_t channel))(void) {
+        (void) channel;
+        return NULL;
+    }
+};
+
+template <uint8_t Channels, uint8_t Id>
+FlowMeterBank<Channels, Id> *FlowMeterBank<Channels, Id>::_instance = NULL;
+
+template <uint8_t Channels, uint8_t Id>
+FlowMeterBank<Channels, Id>::FlowMeterBank() {
+    _instance = this;
+
+    for (uint8_t channel = 0; channel < Channels; channel++) {
+        this->_pins[channel] = 0xff;
+        this->_properties[channel] = &UncalibratedSensor;
+        this->_decileScale[channel] = 10.0f / (UncalibratedSensor.capacity * UncalibratedSensor.kFactor);
+        this->_totalVolume[channel] = 0.0f;
+        this->_totalCorrection[channel] = 0.0f;
+        this->_channelDuration[channel] = 0;
+    }
+
+    this->reset();
+}
+
+template <uint8_t Channels, uint8_t Id>
+FlowMeterBank<Channels, Id>::~FlowMeterBank() {
+    for (uint8_t channel = 0; channel < Channels; channel++) {
+        this->detach(channel);
+    }
+
+    _instance = NULL;
+}
+
+template <uint8_t Channels, uint8_t Id>
+FlowMeterBank<Channels, Id>* FlowMeterBank<Channels, Id>::attach(uint8_t channel, uint8_t pin, const FlowSensorProperties &prop, uint8_t interruptMode) {
+    if (channel >= Channels) {
+        return this;                                                        // no such channel
+    }
+
+    this->detach(channel);
+
+    this->_pins[channel] = pin;
+    this->_properties[channel] = &prop;
+    this->_decileScale[channel] = 10.0f / (prop.capacity * prop.kFactor);
+    this->_sampledPulses[channel] = this->_pulses[channel].read();         // ignore pulses generated during initialisation
+
+    pinMode(pin, INPUT_PULLUP);                                             // initialize interrupt pin as input with pullup
+    attachInterrupt(digitalPinToInterrupt(pin), FlowMeterBankTrampoline<FlowMeterBank, 0, Channels>::get(channel), interruptMode);
+
+    return this;
+}
+
+template <uint8_t Channels, uint8_t Id>
+FlowMeterBank<Channels, Id>* FlowMeterBank<Channels, Id>::detach(uint8_t channel) {
+    if (channel < Channels && this->_pins[channel] != 0xff) {
+        detachInterrupt(digitalPinToInterrupt(this->_pins[channel]));
+        this->_pins[channel] = 0xff;
+    }
+
+    return this;
+}
+
+/**
+ * See FlowMeter::update() for the formulae, this is the same calculation for all channels at once.
+ *
+ * @param duration The update duration (in ms).
+ */
+template <uint8_t Channels, uint8_t Id>
+void FlowMeterBank<Channels, Id>::update(unsigned long duration) {
+    /* sampling (all counters in one pass, so that the channels share the same period) */
+    for (uint8_t channel = 0; channel < Channels; channel++) {
+        unsigned long count = this->_pulses[channel].read();
+        this->_currentPulses[channel] = count - this->_sampledPulses[channel];
+        this->_sampledPulses[channel] = count;
+    }
+
+    /* normalisation (shared by all channels) */
+    double perSecond = 1000.0 / duration;                                   // normalised frequency per pulse (in 1/s)
+
+    /* determine decile and accumulate totals */
+    for (uint8_t channel = 0; channel < Channels; channel++) {
+        if (this->_pins[channel] == 0xff) {
+            this->_currentPulses[channel] = 0;                              // not attached: pulses counted by hand are dropped
+            continue;
+        }
+
+        const FlowSensorProperties *properties = this->_properties[channel];
+        unsigned long pulses = this->_currentPulses[channel];
+        unsigned int decile = (unsigned int) (pulses * perSecond * this->_decileScale[channel]);
+        if (decile > 9) decile = 9;                                         // highest possible decile index
+
+        double correction = properties->kFactor / properties->mFactor[decile];
+        this->_currentDecile[channel] = decile;
+        this->_totalVolume[channel] += pulses / correction / 60.0f;         // V = p / K / 60 (in l)
+        this->_totalCorrection[channel] += correction * duration;
+        this->_channelDuration[channel] += duration;
+    }
+
+    /* update statistics: */
+    this->_currentDuration = duration;
+    this->_totalDuration += duration;
+}
+
+template <uint8_t Channels, uint8_t Id>
+void FlowMeterBank<Channels, Id>::count(uint8_t channel) {
+    if (channel >= Channels) return;
+    this->_pulses[channel].increment();                                     // this should be called from an interrupt service routine
+}
+
+template <uint8_t Channels, uint8_t Id>
+void FlowMeterBank<Channels, Id>::reset() {
+    for (uint8_t channel = 0; channel < Channels; channel++) {
+        this->_sampledPulses[channel] = this->_pulses[channel].read();      // skip pulses counted so far
+        this->_currentPulses[channel] = 0;
+        this->_currentDecile[channel] = 0;
+    }
+
+    this->_currentDuration = 0;
+}
+
+template <uint8_t Channels, uint8_t Id>
+double FlowMeterBank<Channels, Id>::getCurrentFlowrate(uint8_t channel) {
+    if (channel >= Channels) return 0.0f;
+    const FlowSensorProperties *properties = this->_properties[channel];
+    return this->getCurrentFrequency(channel) * properties->mFactor[this->_currentDecile[channel]] / properties->kFactor;   // in l/min
+}
+
+template <uint8_t Channels, uint8_t Id>
+double FlowMeterBank<Channels, Id>::getCurrentVolume(uint8_t channel) {
+    if (channel >= Channels) return 0.0f;
+    const FlowSensorProperties *properties = this->_properties[channel];
+    return this->_currentPulses[channel] * properties->mFactor[this->_currentDecile[channel]] / properties->kFactor / 60.0f;   // in l
+}
+
+template <uint8_t Channels, uint8_t Id>
+double FlowMeterBank<Channels, Id>::getCurrentFrequency(uint8_t channel) {
+    if (channel >= Channels || this->_currentDuration == 0) return 0.0f;
+    return this->_currentPulses[channel] * 1000.0 / this->_currentDuration;    // in 1/s
+}
+
+template <uint8_t Channels, uint8_t Id>
+double FlowMeterBank<Channels, Id>::getCurrentError(uint8_t channel) {
+    if (channel >= Channels) return 0.0f;
+    return (this->_properties[channel]->mFactor[this->_currentDecile[channel]] - 1) * 100;   // in %, see FlowMeter::getCurrentError()
+}
+
+template <uint8_t Channels, uint8_t Id>
+double FlowMeterBank<Channels, Id>::getTotalFlowrate(uint8_t channel) {
+    if (channel >= Channels) return 0.0f;
+    return this->_totalVolume[channel] / (this->_channelDuration[channel] / 1000.0) * 60.0;     // in l/min
+}
+
+template <uint8_t Channels, uint8_t Id>
+double FlowMeterBank<Channels, Id>::getTotalVolume(uint8_t channel) {
+    if (channel >= Channels) return 0.0f;
+    return this->_totalVolume[channel];                                     // in l
+}
+
+template <uint8_t Channels, uint8_t Id>
+double FlowMeterBank<Channels, Id>::getTotalError(uint8_t channel) {
+    if (channel >= Channels) return 0.0f;
+    return (this->_properties[channel]->kFactor / this->_totalCorrection[channel] * this->_channelDuration[channel] - 1) * 100;   // in %, see FlowMeter::getTotalError()
+}
+
+template <uint8_t Channels, uint8_t Id>
+unsigned long FlowMeterBank<Channels, Id>::getCurrentDuration() {
+    return this->_currentDuration;                                          // in ms
+}
+
+template <uint8_t Channels, uint8_t Id>
+unsigned long FlowMeterBank<Channels, Id>::getTotalDuration() {
+    return this->_totalDuration;                                            // in ms
+}
+
+template <uint8_t Channels, uint8_t Id>
+unsigned long FlowMeterBank<Channels, Id>::getTotalDuration(uint8_t channel) {
+    if (channel >= Channels) return 0;
+    return this->_channelDuration[channel];                                 // in ms
+}
+
+template <uint8_t Channels, uint8_t Id>
+uint8_t FlowMeterBank<Channels, Id>::getPin(uint8_t channel) {
+    if (channel >= Channels) return 0xff;
+    return this->_pins[channel];
+}
+
+template <uint8_t Channels, uint8_t Id>
+bool FlowMeterBank<Channels, Id>::isAttached(uint8_t channel) {
+    return channel < Channels && this->_pins[channel] != 0xff;
+}
+
+template <uint8_t Channels, uint8_t Id>
+FlowMeterBank<Channels, Id>* FlowMeterBank<Channels, Id>::setTotalDuration(unsigned long totalDuration) {
+    this->_totalDuration = totalDuration;
+
+    for (uint8_t channel = 0; channel < Channels; channel++) {
+        this->_channelDuration[channel] = totalDuration;
+    }
+
+    return this;
+}
+
+template <uint8_t Channels, uint8_t Id>
+FlowMeterBank<Channels, Id>* FlowMeterBank<Channels, Id>::setTotalDuration(uint8_t channel, unsigned long totalDuration) {
+    if (channel >= Channels) return this;
+    this->_channelDuration[channel] = totalDuration;
+    return this;
+}
+
+template <uint8_t Channels, uint8_t Id>
+FlowMeterBank<Channels, Id>* FlowMeterBank<Channels, Id>::setTotalVolume(uint8_t channel, double totalVolume) {
+    if (channel >= Channels) return this;
+    this->_totalVolume[channel] = totalVolume;
+    return this;
+}
+
+template <uint8_t Channels, uint8_t Id>
+FlowMeterBank<Channels, Id>* FlowMeterBank<Channels, Id>::setTotalCorrection(uint8_t channel, double totalCorrection) {
+    if (channel >= Channels) return this;
+    this->_totalCorrection[channel] = totalCorrection;
+    return this;
+}
+
+#endif   // _FLOWMETERBANK_H_
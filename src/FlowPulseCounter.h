@@ -0,0 +1,76 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWPULSECOUNTER_H_
+#define _FLOWPULSECOUNTER_H_
+
+#if !defined(ARDUINO)
+#include <atomic>
+#endif
+
+/**
+ * FlowPulseCounter
+ *
+ * A monotonically increasing pulse counter with a single writer (the interrupt service routine).
+ *
+ * Readers never reset the counter, they take the difference to their previous reading instead (which is safe across wrap-around).
+ * So sampling works without disabling interrupts: on 8-bit platforms, where reading the counter takes several instructions,
+ * the value is read twice until both readings agree. Hosted builds use an atomic instead, so that pulses may come from another thread.
+ */
+class FlowPulseCounter {
+  public:
+#if !defined(ARDUINO)
+    FlowPulseCounter() {};
+    FlowPulseCounter(const FlowPulseCounter &counter) : _count(counter._count.load(std::memory_order_acquire)) {};   // (copyable like the volatile counter)
+    FlowPulseCounter &operator=(const FlowPulseCounter &counter) {
+        this->_count.store(counter._count.load(std::memory_order_acquire), std::memory_order_release);
+        return *this;
+    }
+
+#endif
+    void increment() {                           // Counts one pulse (writer only, e.g. from an interrupt service routine).
+#if defined(ARDUINO)
+        this->_count++;
+#else
+        this->_count.store(this->_count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+#endif
+    }
+
+    void add(unsigned long pulses) {             // Counts several pulses at once (writer only).
+#if defined(ARDUINO)
+        this->_count += pulses;
+#else
+        this->_count.store(this->_count.load(std::memory_order_relaxed) + pulses, std::memory_order_release);
+#endif
+    }
+
+    unsigned long read() {                       // Returns the number of pulses counted so far (safe from any context).
+#if defined(ARDUINO)
+        unsigned long count;
+
+        do {
+            count = this->_count;                // repeat if the writer got in between
+        } while (count != this->_count);
+
+        return count;
+#else
+        return this->_count.load(std::memory_order_acquire);
+#endif
+    }
+
+  protected:
+#if defined(ARDUINO)
+    volatile unsigned long _count = 0;           // pulses since construction (wraps around)
+#else
+    std::atomic<unsigned long> _count{0};        // pulses since construction (wraps around)
+#endif
+};
+
+#endif   // _FLOWPULSECOUNTER_H_
@@ -0,0 +1,33 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWPULSESOURCE_H_
+#define _FLOWPULSESOURCE_H_
+
+/**
+ * FlowPulseSource
+ *
+ * Counts sensor pulses somewhere other than in count(), e.g. in a hardware timer/counter.
+ *
+ * By default a flow meter counts pulses itself, with one count() interrupt per pulse. Once a pulse source is set
+ * (see FlowMeter::setPulseSource()), update() reads the source instead, and count() isn't needed at all.
+ * Like FlowPulseCounter, a source only ever counts up (wrapping around) and never resets, so readers take differences.
+ * CaptureFlowMeter timestamps pulses in count(), so it keeps counting them itself.
+ *
+ * See FlowTimerPulseSource.h for the AVR timer/counter and FlowSimulatedPulseSource.h for a source that runs on any clock.
+ */
+class FlowPulseSource {
+  public:
+    virtual ~FlowPulseSource() {}
+
+    virtual unsigned long read() = 0;           // Returns the number of pulses counted so far (wraps around).
+};
+
+#endif   // _FLOWPULSESOURCE_H_
@@ -0,0 +1,187 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWSCHEDULER_H_
+#define _FLOWSCHEDULER_H_
+
+#include "Arduino.h"
+#include "FlowMeter.h"
+
+/**
+ * FlowScheduler
+ *
+ * Updates up to Meters flow meters on time without blocking, e.g.: FlowScheduler<2> Scheduler; Scheduler.attach(*Meter); ... Scheduler.poll();
+ *
+ * poll() is meant to be called from loop() as often as possible. It updates every meter whose tick is due,
+ * with the duration that actually elapsed since its previous update (rather than the nominal period), so late ticks cost no volume.
+ * Deadlines advance by whole periods from the previous deadline, so ticks don't drift with the time poll() takes to come around
+ * (unless it's late by more than a period, then the schedule restarts from now).
+ *
+ * Time is kept with millis() in 32 bits, as on the Arduino, and compared by differences only, so the schedule runs across the
+ * millis() rollover after 49.7 days. Ticks may be up to 24.8 days long.
+ *
+ * With setAdaptive(), each meter's period follows its flow: the next tick is made long enough to see the given number of pulses
+ * at the current pulse rate (within the given bounds), i.e. short ticks at high flow and long ticks at trickle flow.
+ *
+ * attach() records the meter's own type, so meters of different types can share a scheduler (e.g. a FlowMeter and a CaptureFlowMeter),
+ * and each one is updated by its own update() (which isn't virtual). Any type with update(duration) and getCurrentFrequency() will do.
+ */
+template <uint8_t Meters = 1>
+class FlowScheduler {
+  public:
+    FlowScheduler(unsigned long period = 1000);  // Initializes the scheduler with the given (initial) tick period (in ms, at least 1).
+
+    template <class Meter>
+    FlowScheduler* attach(Meter &meter);         // Schedules a meter, starting now (ignored if the scheduler is full).
+
+    uint8_t poll();                              // Updates all meters that are due, returns how many were updated.
+
+    FlowScheduler* setPeriod(unsigned long period);   // Uses the given fixed tick period (in ms, at least 1) from the next tick on.
+    FlowScheduler* setAdaptive(unsigned long minimum, unsigned long maximum, unsigned long pulses = 100);   // Adapts the tick period to the flow.
+
+    uint8_t getMeterCount();                     // Returns the number of scheduled meters.
+    unsigned long getPeriod(uint8_t index);      // Returns the current tick period of a meter (in ms).
+
+  protected:
+    template <class Meter>
+    static double tick(void *meter, unsigned long duration);   // Updates a meter of the given type, returns its current pulse rate (in 1/s).
+    unsigned long next(double frequency);        // Returns the period of a meter's next tick at the given pulse rate (in ms).
+
+    void *_meters[Meters];                       // scheduled meters
+    double (*_ticks[Meters])(void *meter, unsigned long duration);   // tick() for the type of each meter
+    uint32_t _updated[Meters];                   // time of each meter's previous update (in ms, wraps around)
+    uint32_t _due[Meters];                       // deadline of each meter's current tick (in ms, wraps around)
+    unsigned long _periods[Meters];              // period of each meter's current tick (in ms)
+    uint8_t _count = 0;                          // number of scheduled meters
+
+    unsigned long _period;                       // fixed tick period (in ms)
+    unsigned long _minimum = 0;                  // shortest adaptive tick period (in ms, 0: not adaptive)
+    unsigned long _maximum = 0;                  // longest adaptive tick period (in ms)
+    unsigned long _pulses = 0;                   // pulses that an adaptive tick aims for
+};
+
+template <uint8_t Meters>
+FlowScheduler<Meters>::FlowScheduler(unsigned long period) :
+    _period(period > 0 ? period : 1)                                        // update(0) would divide by zero
+{
+}
+
+template <uint8_t Meters>
+template <class Meter>
+FlowScheduler<Meters>* FlowScheduler<Meters>::attach(Meter &meter) {
+    if (this->_count >= Meters) {
+        return this;
+    }
+
+    uint32_t now = millis();
+    uint8_t index = this->_count++;
+
+    this->_meters[index] = &meter;
+    this->_ticks[index] = &FlowScheduler::tick<Meter>;
+    this->_updated[index] = now;
+    this->_periods[index] = this->_minimum > 0 ? this->_maximum : this->_period;   // no flow known yet
+    this->_due[index] = now + this->_periods[index];
+
+    return this;
+}
+
+/**
+ * Updates all meters whose tick is due.
+ *
+ * Each due meter gets the exact time since its previous update, so the ticks add up to the real run time
+ * (up to the resolution of millis()) no matter how late poll() comes around.
+ *
+ * @return The number of meters updated.
+ */
+template <uint8_t Meters>
+uint8_t FlowScheduler<Meters>::poll() {
+    uint32_t now = millis();
+    uint8_t updates = 0;
+
+    for (uint8_t index = 0; index < this->_count; index++) {
+        if ((int32_t) (now - this->_due[index]) < 0) {
+            continue;                                                       // not yet due (wrap-around safe)
+        }
+
+        double frequency = this->_ticks[index](this->_meters[index], now - this->_updated[index]);   // true duration (wrap-around safe)
+        this->_updated[index] = now;
+
+        unsigned long period = this->next(frequency);
+        uint32_t deadline = this->_due[index] + period;                     // drift-free: count from the previous deadline
+
+        if ((int32_t) (now - deadline) >= 0) {
+            deadline = now + period;                                        // more than a period late: restart the schedule
+        }
+
+        this->_periods[index] = period;
+        this->_due[index] = deadline;
+        updates++;
+    }
+
+    return updates;
+}
+
+template <uint8_t Meters>
+FlowScheduler<Meters>* FlowScheduler<Meters>::setPeriod(unsigned long period) {
+    this->_period = period > 0 ? period : 1;                                // update(0) would divide by zero
+    this->_minimum = 0;
+    return this;
+}
+
+/**
+ * Adapts the tick period of every meter to its flow.
+ *
+ * @param minimum The shortest tick period (in ms), e.g. at capacity.
+ * @param maximum The longest tick period (in ms), e.g. without any flow.
+ * @param pulses The number of pulses that a tick should see (at least 1, more pulses mean less quantisation noise, but longer ticks).
+ */
+template <uint8_t Meters>
+FlowScheduler<Meters>* FlowScheduler<Meters>::setAdaptive(unsigned long minimum, unsigned long maximum, unsigned long pulses) {
+    this->_minimum = minimum > 0 ? minimum : 1;
+    this->_maximum = max(maximum, this->_minimum);
+    this->_pulses = pulses > 0 ? pulses : 1;                                // without flow, 0 / 0 pulses would give no period at all
+    return this;
+}
+
+template <uint8_t Meters>
+uint8_t FlowScheduler<Meters>::getMeterCount() {
+    return this->_count;
+}
+
+template <uint8_t Meters>
+unsigned long FlowScheduler<Meters>::getPeriod(uint8_t index) {
+    return this->_periods[index];
+}
+
+template <uint8_t Meters>
+template <class Meter>
+double FlowScheduler<Meters>::tick(void *meter, unsigned long duration) {
+    Meter *typed = (Meter *) meter;                                         // as attached
+
+    typed->update(duration);
+    return typed->getCurrentFrequency();
+}
+
+template <uint8_t Meters>
+unsigned long FlowScheduler<Meters>::next(double frequency) {
+    if (this->_minimum == 0) {
+        return this->_period;                                               // fixed period
+    }
+
+    if (frequency * this->_maximum < this->_pulses * 1000.0f) {
+        return this->_maximum;                                              // trickle flow (or none)
+    }
+
+    unsigned long period = this->_pulses * 1000.0f / frequency;             // time to see the desired pulses (in ms)
+
+    return max(period, this->_minimum);
+}
+
+#endif   // _FLOWSCHEDULER_H_
@@ -9,9 +9,10 @@
  */
 
 #ifndef _FLOWSENSORCALIBRATION_H_
-#define _FLOWSENSORCALIBRATION_H_s
+#define _FLOWSENSORCALIBRATION_H_
 
 #include "FlowSensorProperties.h"
+#include "FlowCalibrationCurve.h"
 
 /**
  * FlowSensorCalibration
@@ -59,8 +60,23 @@ class FlowSensorCalibration {
         return this->_properties.mFactor[decile];
     }
 
+    FlowSensorCalibration* addCurvePoint(double frequency, double mFactor) {
+        this->_curve.addPoint(frequency, mFactor);
+        return this;
+    }
+
+    FlowSensorCalibration* clearCurve() {
+        this->_curve.clear();
+        return this;
+    }
+
+    FlowCalibrationCurve getCurve() {            // Returns the calibration curve (converted from the deciles, if no points have been added).
+        return this->_curve.getPointCount() > 0 ? this->_curve : FlowCalibrationCurve(this->_properties);
+    }
+
   protected:
     FlowSensorProperties _properties;
+    FlowCalibrationCurve _curve;
 };
 
 #endif  // _FLOWSENSORCALIBRATION_H_
@@ -25,6 +25,21 @@ typedef struct {
   double mFactor[10];                           // multiplicative correction factor near unity, "meter factor" (per decile of flow)
 } FlowSensorProperties;
 
+/**
+ * Compile-time sensor presets
+ *
+ * Each preset is a type carrying its properties as a constant expression, see StaticFlowMeter.
+ * Custom sensors follow the same pattern (the member also needs a definition in one .cpp file):
+ *
+ *   struct MySensorTraits { static constexpr FlowSensorProperties properties = {60.0f, 5.5f, {1, 1, 1, 1, 1, 1, 1, 1, 1, 1}}; };
+ *   constexpr FlowSensorProperties MySensorTraits::properties;
+ */
+struct UncalibratedSensorTraits { static constexpr FlowSensorProperties properties = {60.0f, 5.0f, {1, 1, 1, 1, 1, 1, 1, 1, 1, 1}}; };
+struct FS300ATraits { static constexpr FlowSensorProperties properties = {60.0f, 5.5f, {1, 1, 1, 1, 1, 1, 1, 1, 1, 1}}; };
+struct FS400ATraits { static constexpr FlowSensorProperties properties = {60.0f, 4.8f, {1, 1, 1, 1, 1, 1, 1, 1, 1, 1}}; };
+struct FS400A_calTraits { static constexpr FlowSensorProperties properties = {30.0f, 4.25f, {1.01695, 1.01695, 1.01695, 1.01695, 1, 0.99767, 0.99767, 0.99767, 1, 1.01695}}; };
+struct FHKCS_1mm_0degTraits { static constexpr FlowSensorProperties properties = {0.4, 39.7, {1.0, 0.995, 0.9925, 0.992, 0.9925, 0.994, 0.995, 0.9975, 1.00125, 1.006}}; };
+
 extern FlowSensorProperties UncalibratedSensor; // default sensor
 extern FlowSensorProperties FS300A;             // see documentation about FS300A/SEN02141B
 extern FlowSensorProperties FS400A;             // see documentation about FS400A/USN-HS10TA
@@ -0,0 +1,43 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "Arduino.h"
+#include "FlowSimulatedPulseSource.h"                                       // https://github.com/sekdiy/FlowMeter
+
+FlowSimulatedPulseSource::FlowSimulatedPulseSource(double frequency) :
+    _frequency(frequency),
+    _micros(micros())
+{
+}
+
+unsigned long FlowSimulatedPulseSource::read() {
+    this->advance();
+    return this->_count;
+}
+
+FlowSimulatedPulseSource* FlowSimulatedPulseSource::setFrequency(double frequency) {
+    this->advance();                                                        // the old rate applies up to now
+    this->_frequency = frequency;
+    return this;
+}
+
+double FlowSimulatedPulseSource::getFrequency() {
+    return this->_frequency;
+}
+
+void FlowSimulatedPulseSource::advance() {
+    unsigned long now = micros();
+    double pulses = this->_carry + this->_frequency * (now - this->_micros) / 1000000.0;   // (wrap-around safe)
+    unsigned long whole = (unsigned long) pulses;
+
+    this->_carry = pulses - whole;
+    this->_count += whole;
+    this->_micros = now;
+}
@@ -0,0 +1,42 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWSIMULATEDPULSESOURCE_H_
+#define _FLOWSIMULATEDPULSESOURCE_H_
+
+#include "FlowPulseSource.h"
+
+/**
+ * FlowSimulatedPulseSource
+ *
+ * A pulse source that produces pulses at a set rate, by micros(), as a hardware counter clocked by the sensor would.
+ *
+ * Fractions of a pulse carry over to the next reading, so the count is exact over any number of readings.
+ * On the host, use it together with simulated time (nativeSetMicros() and nativeAdvanceMicros()) for reproducible runs.
+ */
+class FlowSimulatedPulseSource : public FlowPulseSource {
+  public:
+    FlowSimulatedPulseSource(double frequency = 0.0f);    // Starts producing pulses at the given rate (in 1/s).
+
+    unsigned long read();
+
+    FlowSimulatedPulseSource* setFrequency(double frequency);  // Changes the pulse rate from now on (in 1/s).
+    double getFrequency();                                     // Returns the pulse rate (in 1/s).
+
+  protected:
+    void advance();                              // Counts the pulses produced since the previous reading.
+
+    double _frequency;                           // pulse rate (in 1/s)
+    unsigned long _count = 0;                    // pulses produced so far (wraps around)
+    double _carry = 0.0f;                        // fraction of a pulse produced so far
+    unsigned long _micros;                       // time of the previous reading (in us)
+};
+
+#endif   // _FLOWSIMULATEDPULSESOURCE_H_
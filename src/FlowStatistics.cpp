@@ -0,0 +1,142 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "FlowStatistics.h"                                                 // https://github.com/sekdiy/FlowMeter
+
+FlowStatisticsBase::FlowStatisticsBase(double *values, uint8_t *minimum, uint8_t *maximum, uint8_t window) :
+    _values(values),
+    _minimum(minimum),
+    _maximum(maximum),
+    _window(window),
+    _alpha(2.0f / (window + 1))                                             // same mean age as the moving average
+{
+}
+
+/**
+ * Adds the value of one tick.
+ *
+ * The oldest value leaves the window when its ring position is reused, so it can only ever be at the front of a deque.
+ * New values drop all values from the back of a deque that they outrank (they're older and can never be the extreme again),
+ * so every value enters and leaves each deque once, which makes the minimum and maximum O(1) per tick on average.
+ *
+ * @param value The value of the current tick (e.g. the flow rate, in l/min).
+ */
+void FlowStatisticsBase::add(double value) {
+    uint8_t position = this->_head;
+    double delta = value;                                                   // change of the running sum
+
+    if (this->_count == this->_window) {                                    // window full: evict the oldest value
+        delta -= this->_values[position];
+
+        if (this->_minimum[this->_minimumFront] == position) {              // (a full window has non-empty deques)
+            this->_minimumFront = this->wrap(this->_minimumFront + 1);
+            this->_minimumSize--;
+        }
+
+        if (this->_maximum[this->_maximumFront] == position) {
+            this->_maximumFront = this->wrap(this->_maximumFront + 1);
+            this->_maximumSize--;
+        }
+    } else {
+        this->_smoothed = this->_count == 0 ? value : this->_smoothed;     // seed the weighted average with the first value
+        this->_count++;
+    }
+
+    /* moving average: compensated running sum */
+    double term = delta - this->_compensation;
+    double sum = this->_sum + term;
+    this->_compensation = (sum - this->_sum) - term;
+    this->_sum = sum;
+
+    /* exponentially weighted average */
+    this->_smoothed += this->_alpha * (value - this->_smoothed);
+
+    /* minimum and maximum: monotonic deques */
+    this->_values[position] = value;
+
+    while (this->_minimumSize > 0) {
+        uint8_t back = this->wrap(this->_minimumFront + this->_minimumSize - 1);
+        if (this->_values[this->_minimum[back]] < value) break;
+        this->_minimumSize--;
+    }
+
+    this->_minimum[this->wrap(this->_minimumFront + this->_minimumSize++)] = position;
+
+    while (this->_maximumSize > 0) {
+        uint8_t back = this->wrap(this->_maximumFront + this->_maximumSize - 1);
+        if (this->_values[this->_maximum[back]] > value) break;
+        this->_maximumSize--;
+    }
+
+    this->_maximum[this->wrap(this->_maximumFront + this->_maximumSize++)] = position;
+
+    this->_head = this->wrap(position + 1);
+}
+
+void FlowStatisticsBase::clear() {
+    this->_head = 0;
+    this->_count = 0;
+    this->_minimumFront = 0;
+    this->_minimumSize = 0;
+    this->_maximumFront = 0;
+    this->_maximumSize = 0;
+    this->_sum = 0.0f;
+    this->_compensation = 0.0f;
+    this->_smoothed = 0.0f;
+}
+
+FlowStatisticsBase* FlowStatisticsBase::setSmoothing(double alpha) {
+    this->_alpha = alpha;
+    return this;
+}
+
+uint8_t FlowStatisticsBase::getWindow() {
+    return this->_window;
+}
+
+uint8_t FlowStatisticsBase::getCount() {
+    return this->_count;
+}
+
+double FlowStatisticsBase::getLatest() {
+    if (this->_count == 0) {
+        return 0.0f;
+    }
+
+    return this->_values[this->_head == 0 ? this->_window - 1 : this->_head - 1];
+}
+
+double FlowStatisticsBase::getAverage() {
+    if (this->_count == 0) {
+        return 0.0f;
+    }
+
+    return this->_sum / this->_count;
+}
+
+double FlowStatisticsBase::getSmoothed() {
+    return this->_smoothed;
+}
+
+double FlowStatisticsBase::getMinimum() {
+    if (this->_count == 0) {
+        return 0.0f;
+    }
+
+    return this->_values[this->_minimum[this->_minimumFront]];
+}
+
+double FlowStatisticsBase::getMaximum() {
+    if (this->_count == 0) {
+        return 0.0f;
+    }
+
+    return this->_values[this->_maximum[this->_maximumFront]];
+}
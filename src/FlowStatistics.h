@@ -0,0 +1,91 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWSTATISTICS_H_
+#define _FLOWSTATISTICS_H_
+
+#include <stdint.h>
+
+/**
+ * FlowStatisticsBase
+ *
+ * Rolling statistics over the flow rates of the most recent ticks, updated in O(1) per tick (amortised for minimum and maximum).
+ *
+ * The moving average keeps a (compensated) running sum, the minimum and maximum keep monotonic deques of ring positions,
+ * and the exponentially weighted average needs no history at all. Every value counts once per tick, regardless of the tick's duration.
+ * The storage is provided by FlowStatistics<Window>, so use that (this class only exists so that a FlowMeter can feed any window size).
+ */
+class FlowStatisticsBase {
+  public:
+    FlowStatisticsBase(const FlowStatisticsBase &) = delete;  // the storage belongs to the derived object, so it can't be copied
+    FlowStatisticsBase &operator=(const FlowStatisticsBase &) = delete;
+
+    void add(double value);                      // Adds the value of one tick (evicting the oldest one if the window is full).
+    void clear();                                // Empties the window and restarts the exponentially weighted average.
+
+    FlowStatisticsBase* setSmoothing(double alpha);  // Sets the weight of the newest value in the exponentially weighted average (0..1].
+
+    uint8_t getWindow();                         // Returns the number of ticks the window holds.
+    uint8_t getCount();                          // Returns the number of ticks currently in the window.
+
+    double getLatest();                          // Returns the newest value (0 if empty).
+    double getAverage();                         // Returns the moving average over the window (0 if empty).
+    double getSmoothed();                        // Returns the exponentially weighted average (0 if empty).
+    double getMinimum();                         // Returns the smallest value in the window (0 if empty).
+    double getMaximum();                         // Returns the largest value in the window (0 if empty).
+
+  protected:
+    FlowStatisticsBase(double *values, uint8_t *minimum, uint8_t *maximum, uint8_t window);
+
+    uint8_t wrap(unsigned int position) {        // Maps a position of up to twice the window into the ring (without a division).
+        return position >= this->_window ? position - this->_window : position;
+    }
+
+    double *_values;                             // ring of the most recent values
+    uint8_t *_minimum;                           // ring positions of ascending values (monotonic deque, front is the minimum)
+    uint8_t *_maximum;                           // ring positions of descending values (monotonic deque, front is the maximum)
+    uint8_t _window;                             // capacity of the ring
+
+    uint8_t _head = 0;                           // ring position of the next value
+    uint8_t _count = 0;                          // number of values in the ring
+    uint8_t _minimumFront = 0;                   // deque position of the minimum
+    uint8_t _minimumSize = 0;                    // number of entries in the minimum deque
+    uint8_t _maximumFront = 0;                   // deque position of the maximum
+    uint8_t _maximumSize = 0;                    // number of entries in the maximum deque
+
+    double _sum = 0.0f;                          // sum of the values in the ring
+    double _compensation = 0.0f;                 // lost low-order bits of the sum (Kahan summation)
+    double _alpha;                               // weight of the newest value in the exponentially weighted average
+    double _smoothed = 0.0f;                     // exponentially weighted average
+};
+
+/**
+ * FlowStatistics
+ *
+ * Rolling statistics over a window of the given number of ticks (1..255), e.g.: FlowStatistics<60> for a minute of one second ticks.
+ *
+ * The window size is a template parameter, so RAM use is fixed at build time (Window * (sizeof(double) + 2) bytes of history)
+ * and nothing is allocated. Attach it to a flow meter with FlowMeter::setStatistics() (with FLOWMETER_HOOKS defined) and it's fed by every update().
+ * The exponentially weighted average defaults to a smoothing of 2 / (Window + 1), i.e. the same mean age as the moving average.
+ */
+template <uint8_t Window>
+class FlowStatistics : public FlowStatisticsBase {
+    static_assert(Window > 0, "FlowStatistics needs a window of at least one tick");
+
+  public:
+    FlowStatistics() : FlowStatisticsBase(_valueStorage, _minimumStorage, _maximumStorage, Window) {}
+
+  protected:
+    double _valueStorage[Window];                // ring of the most recent values
+    uint8_t _minimumStorage[Window];             // minimum deque
+    uint8_t _maximumStorage[Window];             // maximum deque
+};
+
+#endif   // _FLOWSTATISTICS_H_
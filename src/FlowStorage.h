@@ -0,0 +1,35 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWSTORAGE_H_
+#define _FLOWSTORAGE_H_
+
+#include <stdint.h>
+
+/**
+ * FlowStorage
+ *
+ * Byte-addressable non-volatile memory that a FlowTotalizer keeps its snapshots in.
+ *
+ * See FlowEEPROMStorage.h for the AVR EEPROM, and extras/native/FlowFileStorage.h for a memory-mapped file on the host.
+ * Other media (e.g. FRAM or flash emulated EEPROM) only need to implement these methods.
+ * Erased memory is expected to read as 0xff, but anything that fails the snapshot checksum is treated as erased.
+ */
+class FlowStorage {
+  public:
+    virtual ~FlowStorage() {}
+
+    virtual unsigned int size() = 0;                                                    // Returns the size of the memory (in bytes).
+    virtual void read(unsigned int address, uint8_t *data, unsigned int length) = 0;    // Reads bytes from the memory.
+    virtual void write(unsigned int address, const uint8_t *data, unsigned int length) = 0;  // Writes bytes to the memory.
+    virtual void commit() {}                                                            // Makes previous writes durable (if the medium buffers them).
+};
+
+#endif   // _FLOWSTORAGE_H_
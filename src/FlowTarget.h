@@ -0,0 +1,132 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWTARGET_H_
+#define _FLOWTARGET_H_
+
+#include <stddef.h>
+#if !defined(ARDUINO)
+#include <atomic>
+#endif
+
+/**
+ * FlowTarget
+ *
+ * The state of a volume target: the pulses still missing, whether it has been reached, and the callback to call then.
+ *
+ * count() counts the target down (in interrupt context), while the program arms, clears and reads it. On 8-bit platforms the program
+ * does so with interrupts disabled (see FlowMeter::setTarget()). Hosted builds use atomics instead, so that count() may run on
+ * another thread (e.g. a FlowEventPulseSource's reader); counting down then takes a compare-and-swap, so that a target
+ * cleared in between isn't counted past zero.
+ */
+class FlowTarget {
+  public:
+#if !defined(ARDUINO)
+    FlowTarget() {};
+    FlowTarget(const FlowTarget &target) { *this = target; };   // (copyable like the volatile target)
+    FlowTarget &operator=(const FlowTarget &target) {
+        this->_callback.store(target._callback.load(std::memory_order_acquire), std::memory_order_relaxed);
+        this->_reached.store(target._reached.load(std::memory_order_acquire), std::memory_order_relaxed);
+        this->_pulses.store(target._pulses.load(std::memory_order_acquire), std::memory_order_release);
+        return *this;
+    }
+
+#endif
+    void arm(unsigned long pulses, void (*callback)(void)) {   // Arms a target of the given number of pulses (0: none), not reached yet.
+#if defined(ARDUINO)
+        this->_callback = callback;
+        this->_reached = false;
+        this->_pulses = pulses;
+#else
+        this->_pulses.store(0, std::memory_order_relaxed);          // disarm while the callback changes
+        this->_callback.store(callback, std::memory_order_relaxed);
+        this->_reached.store(false, std::memory_order_relaxed);
+        this->_pulses.store(pulses, std::memory_order_release);
+#endif
+    }
+
+    bool countDown() {                           // Counts one pulse off an armed target, returns true if it reached the target.
+#if defined(ARDUINO)
+        return this->_pulses != 0 && --this->_pulses == 0;
+#else
+        unsigned long missing = this->_pulses.load(std::memory_order_acquire);
+
+        do {
+            if (missing == 0) return false;      // no target armed (or cleared in between)
+        } while (!this->_pulses.compare_exchange_weak(missing, missing - 1, std::memory_order_acq_rel, std::memory_order_acquire));
+
+        return missing == 1;
+#endif
+    }
+
+    bool countDown(unsigned long pulses) {       // Counts several pulses off an armed target, returns true if they reached the target.
+#if defined(ARDUINO)
+        if (this->_pulses == 0) return false;
+        if (pulses < this->_pulses) {
+            this->_pulses -= pulses;
+            return false;
+        }
+
+        this->_pulses = 0;
+        return true;
+#else
+        unsigned long missing = this->_pulses.load(std::memory_order_acquire);
+
+        do {
+            if (missing == 0) return false;
+        } while (!this->_pulses.compare_exchange_weak(missing, pulses < missing ? missing - pulses : 0, std::memory_order_acq_rel, std::memory_order_acquire));
+
+        return pulses >= missing;
+#endif
+    }
+
+    void reach() {                               // Marks the target reached and calls its callback.
+#if defined(ARDUINO)
+        this->_reached = true;
+        void (*callback)(void) = this->_callback;
+#else
+        this->_reached.store(true, std::memory_order_release);
+        void (*callback)(void) = this->_callback.load(std::memory_order_acquire);
+#endif
+
+        if (callback != NULL) {
+            callback();
+        }
+    }
+
+    unsigned long getPulses() {                  // Returns the pulses still missing (0: no target armed, or reached).
+#if defined(ARDUINO)
+        return this->_pulses;
+#else
+        return this->_pulses.load(std::memory_order_acquire);
+#endif
+    }
+
+    bool isReached() {                           // Tells whether the armed target has been reached.
+#if defined(ARDUINO)
+        return this->_reached;
+#else
+        return this->_reached.load(std::memory_order_acquire);
+#endif
+    }
+
+  protected:
+#if defined(ARDUINO)
+    volatile unsigned long _pulses = 0;          // pulses missing to reach the target (0: no target armed)
+    volatile bool _reached = false;              // whether the armed target has been reached
+    void (*_callback)(void) = NULL;              // target callback (called from count(), i.e. in interrupt context)
+#else
+    std::atomic<unsigned long> _pulses{0};       // pulses missing to reach the target (0: no target armed)
+    std::atomic<bool> _reached{false};           // whether the armed target has been reached
+    std::atomic<void (*)(void)> _callback{NULL}; // target callback (called from count(), i.e. on the thread that counts)
+#endif
+};
+
+#endif   // _FLOWTARGET_H_
@@ -0,0 +1,151 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include "FlowChecksum.h"
+#include "FlowTelemetry.h"                                                  // https://github.com/sekdiy/FlowMeter
+
+FlowTelemetryBase::FlowTelemetryBase(uint64_t *durations, int64_t *volumes, uint8_t meters) :
+    _durations(durations),
+    _volumes(volumes),
+    _meters(meters)
+{
+    for (uint8_t i = 0; i < meters; i++) {
+        this->_durations[i] = 0;
+        this->_volumes[i] = 0;
+    }
+}
+
+/**
+ * Starts a frame. Add the readings with add(), then call end().
+ *
+ * @param buffer The buffer to encode into (see frameSize() for how large it needs to be).
+ * @param size The size of the buffer (in bytes).
+ * @return Whether the buffer holds at least an empty frame.
+ */
+bool FlowTelemetryBase::begin(uint8_t *buffer, size_t size) {
+    this->_buffer = buffer;
+    this->_size = size;
+    this->_length = headerSize;
+    this->_count = 0;
+    this->_overflow = size < (size_t) headerSize + checksumSize;
+    this->_keyframe = this->_restart || this->_sinceKeyframe + 1 >= this->_interval;
+
+    return !this->_overflow;
+}
+
+/**
+ * Adds a reading to the current frame.
+ *
+ * Volumes are sent in whole ul and flow rates in whole ml/min. The deltas are taken between rounded totals, so rounding never accumulates.
+ *
+ * @param totalDuration The total duration (in ms).
+ * @param totalVolume The total volume (in l).
+ * @param currentFlowrate The current flow rate (in l/min).
+ * @return Whether the reading fit into the buffer (otherwise the frame is lost).
+ */
+bool FlowTelemetryBase::add(uint64_t totalDuration, double totalVolume, double currentFlowrate) {
+    if (this->_overflow || this->_count >= this->_meters || this->_length + readingSize + checksumSize > this->_size) {
+        this->_overflow = true;
+        return false;
+    }
+
+    uint8_t position = this->_count++;
+    double microlitres = totalVolume * 1e6;                                 // (in ul)
+    double rate = currentFlowrate * 1000.0f;                                // (in ml/min)
+    int64_t volume = microlitres + (microlitres < 0.0f ? -0.5f : 0.5f);    // round (without llround, which the AVR lacks)
+    int32_t flowrate = rate >= 2147483647.0f ? 2147483647 : (rate <= -2147483647.0f ? -2147483647 : (int32_t) (rate + (rate < 0.0f ? -0.5f : 0.5f)));
+
+    if (this->_keyframe) {
+        this->put(totalDuration);
+        this->putSigned(volume);
+    } else {
+        this->putSigned((int64_t) (totalDuration - this->_durations[position]));   // (wrap-around safe, negative if the meter was reset)
+        this->putSigned(volume - this->_volumes[position]);
+
+        if (position >= this->_previousCount) {
+            this->_restart = true;                                          // the receiver hasn't seen this position yet
+        }
+    }
+
+    this->putSigned(flowrate);
+
+    this->_durations[position] = totalDuration;
+    this->_volumes[position] = volume;
+
+    return true;
+}
+
+/**
+ * Finishes the current frame with the header and checksum.
+ *
+ * @return The length of the frame (in bytes), or 0 if it's lost (then the next frame is a keyframe).
+ */
+size_t FlowTelemetryBase::end() {
+    if (this->_overflow) {
+        this->_restart = true;                                              // the positions may be half updated
+        return 0;
+    }
+
+    uint8_t *frame = this->_buffer;
+
+    frame[0] = sync;
+    frame[1] = version | (this->_keyframe ? keyframe : 0);
+    frame[2] = (uint8_t) this->_sequence;
+    frame[3] = (uint8_t) (this->_sequence >> 8);
+    frame[4] = this->_count;
+
+    uint16_t crc = flowChecksum(frame, this->_length);
+    frame[this->_length++] = (uint8_t) crc;
+    frame[this->_length++] = (uint8_t) (crc >> 8);
+
+    if (this->_keyframe) {
+        this->_sinceKeyframe = 0;
+        this->_restart = false;
+    } else {
+        this->_sinceKeyframe++;
+    }
+
+    this->_previousCount = this->_count;
+    this->_sequence++;
+    this->_frames++;
+
+    return this->_length;
+}
+
+FlowTelemetryBase* FlowTelemetryBase::setKeyframeInterval(uint16_t frames) {
+    this->_interval = frames > 0 ? frames : 1;
+    return this;
+}
+
+FlowTelemetryBase* FlowTelemetryBase::restart() {
+    this->_restart = true;
+    return this;
+}
+
+uint16_t FlowTelemetryBase::getSequence() {
+    return this->_sequence;
+}
+
+unsigned long FlowTelemetryBase::getFrameCount() {
+    return this->_frames;
+}
+
+void FlowTelemetryBase::put(uint64_t value) {
+    while (value >= 0x80) {
+        this->_buffer[this->_length++] = (uint8_t) value | 0x80;
+        value >>= 7;
+    }
+
+    this->_buffer[this->_length++] = (uint8_t) value;
+}
+
+void FlowTelemetryBase::putSigned(int64_t value) {
+    this->put(((uint64_t) value << 1) ^ (uint64_t) (value >> 63));         // zigzag
+}
@@ -0,0 +1,113 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWTELEMETRY_H_
+#define _FLOWTELEMETRY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * FlowTelemetryBase
+ *
+ * Encodes the readings of one or many meters into a compact binary frame, in a buffer provided by the caller (no heap, no String).
+ *
+ * Frame layout (version 1, little-endian):
+ *
+ *   0  sync            uint8_t   (0x46, 'F')
+ *   1  version         uint8_t   (low 7 bits, the top bit marks a keyframe)
+ *   2  sequence        uint16_t  (one more than the previous frame)
+ *   4  meter count     uint8_t
+ *   5  readings        one per meter:
+ *                        total duration  (in ms, keyframe: varint, otherwise: zigzag varint of the change since the previous frame)
+ *                        total volume    (in ul, keyframe: zigzag varint, otherwise: zigzag varint of the change)
+ *                        flow rate       (in ml/min, zigzag varint)
+ *   n  checksum        uint16_t  (CRC-16/CCITT over bytes 0..n-1)
+ *
+ * Varints carry 7 bits per byte, least significant first, with the top bit set on all but the last byte.
+ * Zigzag maps signed to unsigned values (0, -1, 1, -2, ... to 0, 1, 2, 3, ...), so that small changes take few bytes either way.
+ * A reading of a meter that ticks once per second typically takes 5 bytes. Deltas refer to the previous frame's reading
+ * at the same position, so a receiver that lost a frame waits for the next keyframe (every 16 frames by default).
+ * The storage is provided by FlowTelemetry<Meters>, so use that (this class only exists so that any number of meters can share the code).
+ */
+class FlowTelemetryBase {
+  public:
+    static const uint8_t sync = 0x46;            // first byte of every frame
+    static const uint8_t version = 1;            // frame format version
+    static const uint8_t keyframe = 0x80;        // keyframe flag in the version byte
+    static const uint8_t headerSize = 5;         // size of the header (in bytes)
+    static const uint8_t readingSize = 25;       // largest size of a reading (in bytes)
+    static const uint8_t checksumSize = 2;       // size of the checksum (in bytes)
+
+    static constexpr size_t frameSize(uint8_t meters) {  // Returns the largest size of a frame with the given number of meters (in bytes).
+        return headerSize + meters * readingSize + checksumSize;
+    }
+
+    FlowTelemetryBase(const FlowTelemetryBase &) = delete;  // the storage belongs to the derived object, so it can't be copied
+    FlowTelemetryBase &operator=(const FlowTelemetryBase &) = delete;
+
+    bool begin(uint8_t *buffer, size_t size);    // Starts a frame in the given buffer, returns false if it's too small even for an empty frame.
+    bool add(uint64_t totalDuration, double totalVolume, double currentFlowrate);  // Adds a reading (in ms, l and l/min), returns false if it doesn't fit.
+    template <class Meter> bool add(Meter &meter);   // Adds the reading of a FlowMeter (or any other meter with the same getters).
+    size_t end();                                // Finishes the frame, returns its length (0 if a reading didn't fit).
+
+    FlowTelemetryBase* setKeyframeInterval(uint16_t frames);  // Sends absolute totals every given number of frames (at least 1).
+    FlowTelemetryBase* restart();                // Makes the next frame a keyframe.
+
+    uint16_t getSequence();                      // Returns the sequence number of the next frame.
+    unsigned long getFrameCount();               // Returns the number of frames finished so far.
+
+  protected:
+    FlowTelemetryBase(uint64_t *durations, int64_t *volumes, uint8_t meters);
+
+    void put(uint64_t value);                    // Appends a varint.
+    void putSigned(int64_t value);               // Appends a zigzag varint.
+
+    uint64_t *_durations;                        // total duration of each position in the previous frame (in ms)
+    int64_t *_volumes;                           // total volume of each position in the previous frame (in ul)
+    uint8_t _meters;                             // number of positions
+
+    uint8_t *_buffer = NULL;                     // current frame
+    size_t _size = 0;                            // size of the buffer (in bytes)
+    size_t _length = 0;                          // length of the current frame so far (in bytes)
+    bool _overflow = false;                      // whether a reading didn't fit
+    bool _keyframe = false;                      // whether the current frame is a keyframe
+    uint8_t _count = 0;                          // readings in the current frame
+    uint8_t _previousCount = 0;                  // readings in the previous frame
+
+    uint16_t _sequence = 0;                      // sequence number of the next frame
+    uint16_t _interval = 16;                     // frames from one keyframe to the next
+    uint16_t _sinceKeyframe = 0;                 // frames since the last keyframe
+    bool _restart = true;                        // whether the next frame has to be a keyframe
+    unsigned long _frames = 0;                   // frames finished so far
+};
+
+/**
+ * FlowTelemetry
+ *
+ * Telemetry frames for up to Meters meters, e.g.: FlowTelemetry<2> Telemetry; uint8_t frame[FlowTelemetry<2>::frameSize(2)];
+ * Keeps 16 bytes per meter for the deltas.
+ */
+template <uint8_t Meters>
+class FlowTelemetry : public FlowTelemetryBase {
+  public:
+    FlowTelemetry() : FlowTelemetryBase(_durationStorage, _volumeStorage, Meters) {}
+
+  protected:
+    uint64_t _durationStorage[Meters];
+    int64_t _volumeStorage[Meters];
+};
+
+template <class Meter>
+bool FlowTelemetryBase::add(Meter &meter) {
+    return this->add(meter.getTotalDuration64(), meter.getTotalVolume(), meter.getCurrentFlowrate());
+}
+
+#endif   // _FLOWTELEMETRY_H_
@@ -0,0 +1,64 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWTIMERPULSESOURCE_H_
+#define _FLOWTIMERPULSESOURCE_H_
+
+#include "Arduino.h"
+#include "FlowPulseSource.h"
+
+#if !defined(TCNT1)
+#error "FlowTimerPulseSource needs the 16-bit Timer1 of an AVR"
+#endif
+
+/**
+ * FlowTimerPulseSource
+ *
+ * Counts pulses in the 16-bit Timer1, clocked by the sensor on the T1 pin (D5 on the ATmega328P, e.g. Uno and Nano, D12 on the ATmega32U4).
+ *
+ * The timer counts every edge in hardware, so pulses cost no CPU time at all and add no interrupt latency.
+ * The 16-bit count is extended on every read(), so read (i.e. update()) at least once per 65535 pulses.
+ * Timer1 is then no longer available for PWM on its pins, nor for libraries that use it (e.g. Servo).
+ * Call begin() in setup(), because the Arduino core claims Timer1 for PWM before setup() runs.
+ */
+class FlowTimerPulseSource : public FlowPulseSource {
+  public:
+    FlowTimerPulseSource(uint8_t interruptMode = RISING) : _interruptMode(interruptMode) {}
+
+    void begin() {                               // Takes over Timer1 and starts counting.
+        noInterrupts();
+        TCCR1A = 0;                              // normal mode, no outputs
+        TCCR1B = this->_interruptMode == FALLING ?
+            (1 << CS12) | (1 << CS11) :          // external clock on T1, falling edge
+            (1 << CS12) | (1 << CS11) | (1 << CS10);   // external clock on T1, rising edge
+        TIMSK1 = 0;                              // no timer interrupts
+        TCNT1 = 0;
+        this->_last = 0;
+        interrupts();
+    }
+
+    unsigned long read() {
+        noInterrupts();                          // 16-bit register reads share a temporary register with other ISRs
+        uint16_t now = TCNT1;
+        interrupts();
+
+        this->_count += (uint16_t) (now - this->_last);  // (wrap-around safe)
+        this->_last = now;
+
+        return this->_count;
+    }
+
+  protected:
+    uint8_t _interruptMode;                      // counted edge (RISING or FALLING)
+    uint16_t _last = 0;                          // timer count at the previous reading
+    unsigned long _count = 0;                    // pulses counted so far (wraps around)
+};
+
+#endif   // _FLOWTIMERPULSESOURCE_H_
@@ -0,0 +1,174 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <string.h>
+#include "FlowChecksum.h"
+#include "FlowTotalizer.h"                                                  // https://github.com/sekdiy/FlowMeter
+
+static void put(uint8_t *data, uint64_t value, uint8_t length) {
+    for (uint8_t i = 0; i < length; i++) {
+        data[i] = (uint8_t) (value >> (8 * i));                             // little-endian
+    }
+}
+
+static uint64_t get(const uint8_t *data, uint8_t length) {
+    uint64_t value = 0;
+
+    for (uint8_t i = 0; i < length; i++) {
+        value |= (uint64_t) data[i] << (8 * i);
+    }
+
+    return value;
+}
+
+FlowTotalizer::FlowTotalizer(FlowStorage &storage, unsigned int address, unsigned int length) :
+    _storage(storage),
+    _address(address)
+{
+    if (length == 0) {
+        length = address < storage.size() ? storage.size() - address : 0;  // up to the end of the memory
+    }
+
+    this->_slots = length / recordSize;
+}
+
+/**
+ * Finds the newest valid record, reading every slot once (so boot time is bounded by the size of the region).
+ *
+ * Sequence numbers are compared by their (wrap-around safe) difference, so the log keeps working after 2^32 snapshots.
+ */
+void FlowTotalizer::scan() {
+    uint8_t record[recordSize];
+
+    this->_found = false;
+
+    for (unsigned int slot = 0; slot < this->_slots; slot++) {
+        this->_storage.read(this->_address + slot * recordSize, record, recordSize);
+
+        if (record[0] != version || get(record + 25, 2) != flowChecksum(record, 25)) {
+            continue;                                                       // erased, torn or foreign record
+        }
+
+        uint32_t sequence = get(record + 1, 4);
+
+        if (this->_found && (int32_t) (sequence - this->_sequence) <= 0) {
+            continue;                                                       // older than the newest so far
+        }
+
+        uint32_t bits = get(record + 21, 4);
+        float correction;
+        memcpy(&correction, &bits, sizeof(correction));                     // IEEE 754 single precision
+
+        this->_found = true;
+        this->_newest = slot;
+        this->_sequence = sequence;
+        this->_saved.totalDuration = get(record + 5, 8);
+        this->_saved.totalVolume = get(record + 13, 8) / 1e6;               // ul to l
+        this->_saved.totalCorrection = (double) correction * this->_saved.totalDuration;
+    }
+
+    this->_scanned = true;
+}
+
+bool FlowTotalizer::load(FlowSnapshot &snapshot) {
+    this->scan();                                                           // always re-read, the memory may have changed since
+
+    if (this->_found) {
+        snapshot = this->_saved;
+    }
+
+    return this->_found;
+}
+
+bool FlowTotalizer::save(const FlowSnapshot &snapshot) {
+    if (this->_slots < 2) {
+        return false;                                                       // a single slot would overwrite the only valid record
+    }
+
+    if (!this->_scanned) {
+        this->scan();                                                       // continue the log where it ended
+    }
+
+    uint8_t record[recordSize];
+    float correction = snapshot.totalDuration > 0 ? snapshot.totalCorrection / snapshot.totalDuration : 0.0f;
+    uint32_t bits;
+    unsigned int slot = this->_found ? (this->_newest + 1 == this->_slots ? 0 : this->_newest + 1) : 0;
+    uint32_t sequence = this->_found ? this->_sequence + 1 : 0;
+
+    memcpy(&bits, &correction, sizeof(bits));
+
+    record[0] = version;
+    put(record + 1, sequence, 4);
+    put(record + 5, snapshot.totalDuration, 8);
+    put(record + 13, (uint64_t) (snapshot.totalVolume * 1e6 + 0.5), 8);    // l to ul (rounded)
+    put(record + 21, bits, 4);
+    put(record + 25, flowChecksum(record, 25), 2);
+
+    this->_storage.write(this->_address + slot * recordSize, record, recordSize);
+    this->_storage.commit();
+
+    this->_found = true;
+    this->_newest = slot;
+    this->_sequence = sequence;
+    this->_saved = snapshot;
+    this->_writes++;
+
+    return true;
+}
+
+void FlowTotalizer::erase() {
+    uint8_t record[recordSize];
+
+    memset(record, 0xff, recordSize);
+
+    for (unsigned int slot = 0; slot < this->_slots; slot++) {
+        this->_storage.write(this->_address + slot * recordSize, record, recordSize);
+    }
+
+    this->_storage.commit();
+
+    this->_scanned = true;
+    this->_found = false;
+}
+
+bool FlowTotalizer::due(const FlowSnapshot &snapshot) {
+    if (!this->_scanned) {
+        this->scan();
+    }
+
+    if (!this->_found) {
+        return true;                                                        // nothing saved yet
+    }
+
+    if (snapshot.totalDuration < this->_saved.totalDuration || snapshot.totalVolume < this->_saved.totalVolume) {
+        return false;                                                       // behind the saved totals (not restored yet, or reset): don't bury them
+    }
+
+    return (this->_throttleVolume > 0.0f && snapshot.totalVolume - this->_saved.totalVolume >= this->_throttleVolume) ||
+           (this->_throttleDuration > 0 && snapshot.totalDuration - this->_saved.totalDuration >= this->_throttleDuration);
+}
+
+FlowTotalizer* FlowTotalizer::setThrottle(double volume, unsigned long duration) {
+    this->_throttleVolume = volume;
+    this->_throttleDuration = duration;
+    return this;
+}
+
+unsigned int FlowTotalizer::getSlotCount() {
+    return this->_slots;
+}
+
+uint32_t FlowTotalizer::getSequence() {
+    return this->_sequence;
+}
+
+unsigned long FlowTotalizer::getWriteCount() {
+    return this->_writes;
+}
@@ -0,0 +1,137 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _FLOWTOTALIZER_H_
+#define _FLOWTOTALIZER_H_
+
+#include <stdint.h>
+#include "FlowStorage.h"
+
+/**
+ * FlowSnapshot
+ *
+ * The totals of a flow meter, i.e. everything that its setTotal...() methods restore after a power cycle.
+ */
+typedef struct {
+  uint64_t totalDuration;                       // total measured duration (in ms)
+  double totalVolume;                           // total volume (in l)
+  double totalCorrection;                       // accumulated correction factors (over time, in ms)
+} FlowSnapshot;
+
+/**
+ * FlowTotalizer
+ *
+ * Keeps the totals of a flow meter in non-volatile memory, as a circular log of small checksummed records.
+ *
+ * Every snapshot goes to the slot after the newest one, so the writes are spread evenly over the whole region
+ * (e.g. 1 KiB of EEPROM holds 37 slots, which multiplies the endurance of a cell by 37).
+ * A record is written in full before it counts, and the previous one is never touched, so a power cut during a write
+ * loses at most the snapshot being written. On boot, load() reads every slot once and picks the valid record with the highest sequence number.
+ *
+ * Record layout (version 1, little-endian, recordSize bytes):
+ *
+ *   0  version         uint8_t
+ *   1  sequence        uint32_t  (one more than the previous record)
+ *   5  total duration  uint64_t  (in ms)
+ *  13  total volume    uint64_t  (in ul)
+ *  21  correction      float     (average correction factor, i.e. total correction / total duration)
+ *  25  checksum        uint16_t  (CRC-16/CCITT over bytes 0..24)
+ *
+ * Snapshots are throttled: update() only writes once the volume or the duration have grown by the configured amount since the last snapshot.
+ * Totals behind the newest snapshot (e.g. of a meter that hasn't been restored yet) are never written by update(), since the log would
+ * then return them rather than the saved ones. snapshot() writes whatever it is given.
+ */
+class FlowTotalizer {
+  public:
+    static const uint8_t version = 1;           // record format version
+    static const uint8_t recordSize = 27;       // size of a record (in bytes)
+
+    /**
+     * Initializes a new totalizer on a region of the given storage.
+     *
+     * @param storage The non-volatile memory to use.
+     * @param address The start of the region (in bytes).
+     * @param length The length of the region (in bytes, default: up to the end of the memory). Use at least two records.
+     */
+    FlowTotalizer(FlowStorage &storage, unsigned int address = 0, unsigned int length = 0);
+
+    bool load(FlowSnapshot &snapshot);          // Finds the newest valid snapshot, returns false if there is none.
+    bool save(const FlowSnapshot &snapshot);    // Appends a snapshot to the log, returns false if the region is too small.
+    void erase();                               // Invalidates all snapshots in the region.
+
+    template <class Meter> bool restore(Meter &meter);   // Restores the totals of a meter from the newest snapshot (if any).
+    template <class Meter> bool snapshot(Meter &meter);  // Saves the totals of a meter now.
+    template <class Meter> bool update(Meter &meter);    // Saves the totals of a meter if the throttle allows, call after every update().
+
+    FlowTotalizer* setThrottle(double volume, unsigned long duration);  // Sets the growth in volume (in l) or duration (in ms) that triggers a snapshot (0 disables either).
+
+    unsigned int getSlotCount();                // Returns the number of records that fit into the region.
+    uint32_t getSequence();                     // Returns the sequence number of the newest snapshot.
+    unsigned long getWriteCount();              // Returns the number of snapshots written since construction.
+
+  protected:
+    void scan();                                // Locates the newest valid record.
+    bool due(const FlowSnapshot &snapshot);     // Tells whether the throttle allows a snapshot of the given totals.
+
+    FlowStorage &_storage;                      // non-volatile memory
+    unsigned int _address;                      // start of the region (in bytes)
+    unsigned int _slots;                        // number of records in the region
+
+    bool _scanned = false;                      // whether the newest record has been located
+    bool _found = false;                        // whether there is a valid record
+    unsigned int _newest = 0;                   // slot of the newest record
+    uint32_t _sequence = 0;                     // sequence number of the newest record
+    FlowSnapshot _saved = {0, 0.0f, 0.0f};      // totals of the newest record
+
+    double _throttleVolume = 1.0f;              // volume growth that triggers a snapshot (in l)
+    unsigned long _throttleDuration = 3600000;  // duration growth that triggers a snapshot (in ms)
+    unsigned long _writes = 0;                  // snapshots written since construction
+};
+
+/**
+ * Restores the totals of a FlowMeter, StaticFlowMeter, CaptureFlowMeter or FixedFlowMeter.
+ *
+ * @param meter The meter (call this before its first update()).
+ * @return Whether a snapshot was found (otherwise the meter is left untouched).
+ */
+template <class Meter>
+bool FlowTotalizer::restore(Meter &meter) {
+    FlowSnapshot snapshot;
+
+    if (!this->load(snapshot)) {
+        return false;
+    }
+
+    meter.setTotalDuration(snapshot.totalDuration);
+    meter.setTotalVolume(snapshot.totalVolume);
+    meter.setTotalCorrection(snapshot.totalCorrection);
+
+    return true;
+}
+
+template <class Meter>
+bool FlowTotalizer::snapshot(Meter &meter) {
+    FlowSnapshot snapshot = {meter.getTotalDuration64(), meter.getTotalVolume(), meter.getTotalCorrection()};
+    return this->save(snapshot);
+}
+
+/**
+ * Saves the totals of a meter once they have grown by the throttle's volume or duration since the last snapshot (whichever comes first).
+ *
+ * @param meter The meter.
+ * @return Whether a snapshot was written.
+ */
+template <class Meter>
+bool FlowTotalizer::update(Meter &meter) {
+    FlowSnapshot snapshot = {meter.getTotalDuration64(), meter.getTotalVolume(), meter.getTotalCorrection()};
+    return this->due(snapshot) && this->save(snapshot);
+}
+
+#endif   // _FLOWTOTALIZER_H_
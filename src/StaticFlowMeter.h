@@ -0,0 +1,99 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#ifndef _STATICFLOWMETER_H_
+#define _STATICFLOWMETER_H_
+
+#include "FlowMeter.h"
+
+/**
+ * StaticFlowMeter
+ *
+ * A flow meter for a sensor that is fixed when the firmware is built, e.g.: StaticFlowMeter<FS400A_calTraits>.
+ *
+ * The decile scale and the per-decile correction factors (and their reciprocals) are computed by the compiler,
+ * so that update() does without floor() and divides only once (to normalise the tick duration).
+ * Apart from that it behaves exactly like a FlowMeter for the same sensor properties.
+ *
+ * Note that update() hides (rather than overrides) FlowMeter::update(), calls through a FlowMeter pointer take the runtime path.
+ * The calibration can't be changed at runtime: setProperties() is deleted, since update() would keep correcting with the built-in
+ * properties while the totals followed the new ones. Use a FlowMeter if the sensor is calibrated in the field.
+ */
+template <class Sensor>
+class StaticFlowMeter : public FlowMeter {
+  public:
+    /**
+     * Initializes a new flow meter object.
+     *
+     * @param pin  The pin that the flow sensor is connected to (has to be interrupt capable, default: INT0).
+     * @param callback The interrupt callback handler
+     */
+    StaticFlowMeter(unsigned int pin = 2, void (*callback)(void) = NULL, uint8_t interruptMode = RISING) :
+        FlowMeter(pin, Sensor::properties, callback, interruptMode) {}
+
+    void update(unsigned long duration = 1000);  // Updates all internal calculations at the end of a measurement period.
+    void tick(unsigned long duration = 1000) { update(duration); }
+
+    FlowMeter* setProperties(const FlowSensorProperties &properties) = delete;   // The sensor properties are built in.
+
+  protected:
+    static constexpr double _decileScale = 10.0 / (Sensor::properties.capacity * Sensor::properties.kFactor);  // deciles per (1/s)
+
+    static constexpr double _correction[10] = {                            // combined correction factor per decile (k-factor / m-factor)
+        Sensor::properties.kFactor / Sensor::properties.mFactor[0], Sensor::properties.kFactor / Sensor::properties.mFactor[1],
+        Sensor::properties.kFactor / Sensor::properties.mFactor[2], Sensor::properties.kFactor / Sensor::properties.mFactor[3],
+        Sensor::properties.kFactor / Sensor::properties.mFactor[4], Sensor::properties.kFactor / Sensor::properties.mFactor[5],
+        Sensor::properties.kFactor / Sensor::properties.mFactor[6], Sensor::properties.kFactor / Sensor::properties.mFactor[7],
+        Sensor::properties.kFactor / Sensor::properties.mFactor[8], Sensor::properties.kFactor / Sensor::properties.mFactor[9]
+    };
+
+    static constexpr double _reciprocal[10] = {                            // reciprocal correction factor per decile (m-factor / k-factor)
+        Sensor::properties.mFactor[0] / Sensor::properties.kFactor, Sensor::properties.mFactor[1] / Sensor::properties.kFactor,
+        Sensor::properties.mFactor[2] / Sensor::properties.kFactor, Sensor::properties.mFactor[3] / Sensor::properties.kFactor,
+        Sensor::properties.mFactor[4] / Sensor::properties.kFactor, Sensor::properties.mFactor[5] / Sensor::properties.kFactor,
+        Sensor::properties.mFactor[6] / Sensor::properties.kFactor, Sensor::properties.mFactor[7] / Sensor::properties.kFactor,
+        Sensor::properties.mFactor[8] / Sensor::properties.kFactor, Sensor::properties.mFactor[9] / Sensor::properties.kFactor
+    };
+};
+
+template <class Sensor> constexpr double StaticFlowMeter<Sensor>::_decileScale;
+template <class Sensor> constexpr double StaticFlowMeter<Sensor>::_correction[10];
+template <class Sensor> constexpr double StaticFlowMeter<Sensor>::_reciprocal[10];
+
+/**
+ * See FlowMeter::update() for the formulae, this is the same calculation with all sensor constants folded in.
+ *
+ * @param duration The update duration (in ms).
+ */
+template <class Sensor>
+void StaticFlowMeter<Sensor>::update(unsigned long duration) {
+    /* sampling */
+    unsigned long pulses = this->sample();                                  // sample and reset current pulses
+
+    /* normalisation */
+    double frequency = pulses * 1000.0 / duration;                          // normalised frequency (in 1/s)
+
+    /* determine current correction factor (from precomputed tables) */
+    unsigned int decile = (unsigned int) (frequency * _decileScale);         // decile of current flow relative to sensor capacity (truncation is floor here)
+    if (decile > 9) decile = 9;                                             // highest possible decile index
+    this->_currentCorrection = _correction[decile];
+#if defined(FLOWMETER_TOTALIZER)
+    this->_currentDecile = decile;                                          // (for record())
+#endif
+
+    /* update current calculations: */
+    this->_currentFlowrate = frequency * _reciprocal[decile];               // get flow rate (in l/min) from normalised frequency and reciprocal correction factor
+    this->_currentVolume = this->_currentFlowrate * duration * (1.0 / 60000.0);     // get volume (in l) from flow rate and duration
+
+    /* update statistics: */
+    this->record(duration, frequency);
+}
+
+#endif   // _STATICFLOWMETER_H_
@@ -0,0 +1,163 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Tests of leak, burst and stuck sensor detection on synthetic household profiles (run with: pio test -e native).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <random>
+#include <vector>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "FlowAnomalyDetector.h"
+#include "Injected.h"
+
+enum Anomaly {
+    Normal, Leaking, Bursting, Stalled
+};
+
+static const unsigned long onset = 2 * 86400 + 2 * 3600;                    // third day, 02:00 (in s)
+static const unsigned long days = 4;
+
+/**
+ * A synthetic four day flow profile: a household's taps during the day (one use per 20 minutes, from 06:00 to 23:00),
+ * with an anomaly from the third night on.
+ */
+static void household(Anomaly anomaly, std::vector<double> &flow) {
+    std::minstd_rand random(42);
+    std::uniform_int_distribution<unsigned long> start(0, 900), length(30, 300);    // (in s)
+    std::uniform_real_distribution<double> rate(3.0, 12.0);                 // (in l/min)
+
+    flow.assign(days * 86400, 0.0);
+
+    for (unsigned long slot = 0; slot < days * 72; slot++) {               // 20 minute slots
+        unsigned long begin = slot * 1200 + start(random), end = begin + length(random);
+        double tap = rate(random);
+
+        if (begin % 86400 < 6 * 3600 || begin % 86400 >= 23 * 3600) {
+            continue;                                                       // night
+        }
+
+        for (unsigned long tick = begin; tick < end; tick++) {
+            flow[tick] = tap;
+        }
+    }
+
+    for (unsigned long tick = onset; tick < flow.size(); tick++) {
+        switch (anomaly) {
+            case Leaking:  flow[tick] += 0.5; break;                        // 2.4 pulses/s, so every one second tick sees some
+            case Bursting: flow[tick] += tick < onset + 600 ? 25.0 : 0.0; break;   // a ten minute pipe burst at night
+            case Stalled:  flow[tick] = 0.0; break;                         // the sensor dies
+            default: break;
+        }
+    }
+}
+
+static uint8_t raised;                                                      // events raised so far
+static unsigned long current;                                               // current tick
+static unsigned long first;                                                 // tick of the first event
+
+static void callback(uint8_t event) {
+    if (raised == 0) {
+        first = current;
+    }
+
+    raised |= event;
+}
+
+/**
+ * Replays a profile through a meter with an anomaly detector, and checks that exactly the expected event is raised
+ * within the given latency after the anomaly's onset.
+ */
+static void replay(Anomaly anomaly, uint8_t expected, unsigned long latency) {
+    std::vector<double> flow;
+    household(anomaly, flow);
+
+    Injected<FlowMeter> meter(2, UncalibratedSensor);
+    FlowAnomalyDetector detector;
+    detector.setLeak(0.0, 7200000)->setStuck(86400000)->setCallback(callback);   // 2 h of flow is a leak, a day without is a dead sensor
+    meter.setDetector(&detector);
+    double carry = 0.0;
+
+    raised = 0;
+    first = 0;
+
+    for (current = 0; current < flow.size(); current++) {
+        double due = flow[current] * UncalibratedSensor.kFactor + carry;    // pulses of the tick (in 1/s)
+        unsigned long count = (unsigned long) due;
+        carry = due - count;
+
+        meter.inject(count);
+        meter.update(1000);
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(expected, raised);
+
+    if (expected != FlowAnomalyDetector::None) {
+        TEST_ASSERT_GREATER_OR_EQUAL(onset, first);
+        TEST_ASSERT_LESS_OR_EQUAL(latency, first - onset);
+    }
+}
+
+static void test_household(void) {
+    replay(Normal, FlowAnomalyDetector::None, 0);
+}
+
+static void test_leak(void) {
+    replay(Leaking, FlowAnomalyDetector::Leak, 7200 + 60);
+}
+
+static void test_burst(void) {
+    replay(Bursting, FlowAnomalyDetector::Burst, 10);
+}
+
+static void test_stuck(void) {
+    replay(Stalled, FlowAnomalyDetector::Stuck, 86400);
+}
+
+/**
+ * clear() forgets the events and what is normal.
+ */
+static void test_clear(void) {
+    FlowAnomalyDetector detector;
+
+    detector.setStuck(10000);
+
+    for (unsigned int tick = 0; tick < 11; tick++) {
+        detector.add(0.0, 1000);
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(FlowAnomalyDetector::Stuck, detector.getEvents());
+    TEST_ASSERT_EQUAL_UINT32(11000, detector.getIdleDuration());
+
+    detector.clear();
+
+    TEST_ASSERT_EQUAL_UINT8(FlowAnomalyDetector::None, detector.getEvents());
+    TEST_ASSERT_EQUAL_UINT32(0, detector.getIdleDuration());
+    TEST_ASSERT_FALSE(detector.isLearned());
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_household);
+    RUN_TEST(test_leak);
+    RUN_TEST(test_burst);
+    RUN_TEST(test_stuck);
+    RUN_TEST(test_clear);
+    return UNITY_END();
+}
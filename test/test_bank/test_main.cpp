@@ -0,0 +1,151 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Tests of FlowMeterBank against separate FlowMeter objects (run with: pio test -e native).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <random>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "FlowMeterBank.h"
+
+static FlowSensorProperties *sensors[] = {&UncalibratedSensor, &FS300A, &FS400A, &FS400A_cal, &FHKCS_1mm_0deg};
+
+/**
+ * Raises every channel's pin (i.e. its generated interrupt service routine) and counts the same pulses on a separate meter,
+ * then checks that the bank reports what the meters do.
+ */
+static void test_matches_meters(void) {
+    const uint8_t channels = 8;
+    static FlowMeterBank<channels> bank;
+    FlowMeter *meters[channels];
+    std::minstd_rand random(42);
+
+    for (uint8_t channel = 0; channel < channels; channel++) {
+        FlowSensorProperties *sensor = sensors[channel % (sizeof(sensors) / sizeof(sensors[0]))];
+
+        bank.attach(channel, channel, *sensor);
+        TEST_ASSERT_TRUE(bank.isAttached(channel));
+        TEST_ASSERT_EQUAL_UINT8(channel, bank.getPin(channel));
+        meters[channel] = new FlowMeter(channel, *sensor);
+    }
+
+    for (unsigned int tick = 0; tick < 600; tick++) {
+        for (uint8_t channel = 0; channel < channels; channel++) {
+            std::uniform_int_distribution<unsigned long> flow(0, (unsigned long) (meters[channel]->getProperties().capacity * meters[channel]->getProperties().kFactor));
+            unsigned long pulses = flow(random);
+
+            for (unsigned long i = 0; i < pulses; i++) {
+                nativeRaiseInterrupt(channel);
+                meters[channel]->count();
+            }
+
+            meters[channel]->update(1000);
+        }
+
+        bank.update(1000);
+
+        for (uint8_t channel = 0; channel < channels; channel++) {
+            TEST_ASSERT_DOUBLE_WITHIN(1e-9 * (1.0 + meters[channel]->getCurrentFlowrate()), meters[channel]->getCurrentFlowrate(), bank.getCurrentFlowrate(channel));
+            TEST_ASSERT_DOUBLE_WITHIN(1e-12, meters[channel]->getCurrentError(), bank.getCurrentError(channel));
+        }
+    }
+
+    for (uint8_t channel = 0; channel < channels; channel++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9 * meters[channel]->getTotalVolume(), meters[channel]->getTotalVolume(), bank.getTotalVolume(channel));
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9, meters[channel]->getTotalError(), bank.getTotalError(channel));
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9 * (1.0 + meters[channel]->getTotalFlowrate()), meters[channel]->getTotalFlowrate(), bank.getTotalFlowrate(channel));
+        TEST_ASSERT_EQUAL_UINT32(meters[channel]->getTotalDuration(), bank.getTotalDuration(channel));
+        delete meters[channel];
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(600000UL, bank.getTotalDuration());
+}
+
+/**
+ * Channel indices beyond the bank are ignored, rather than written out of bounds, and chained calls go on past them.
+ */
+static void test_channel_range(void) {
+    static FlowMeterBank<4, 1> bank;
+
+    bank.attach(3, 3, FS400A)->setTotalVolume(3, 1.0f);
+    bank.attach(4, 4, FS400A)->attach(255, 5, FS400A)->attach(2, 2, FS400A);
+
+    TEST_ASSERT_FALSE(bank.isAttached(4));
+    TEST_ASSERT_FALSE(bank.isAttached(255));
+    TEST_ASSERT_TRUE(bank.isAttached(2));
+    TEST_ASSERT_EQUAL_UINT8(0xff, bank.getPin(4));
+
+    bank.detach(4)->setTotalVolume(4, 2.0f)->setTotalCorrection(4, 3.0f);
+    bank.count(4);
+    bank.update(1000);
+
+    TEST_ASSERT_EQUAL_UINT8(3, bank.getPin(3));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 1.0, bank.getTotalVolume(3));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 0.0, bank.getTotalVolume(4));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 0.0, bank.getCurrentFrequency(4));
+}
+
+/**
+ * A channel attached later accrues its own duration, so its average flow rate covers its own run time only.
+ */
+static void test_late_attach(void) {
+    static FlowMeterBank<2, 2> bank;
+
+    bank.attach(0, 0, UncalibratedSensor);
+
+    for (unsigned int tick = 0; tick < 60; tick++) {
+        bank.update(1000);                                                  // a minute without flow
+    }
+
+    bank.attach(1, 1, UncalibratedSensor);
+
+    for (unsigned int tick = 0; tick < 60; tick++) {
+        for (unsigned int pulse = 0; pulse < 50; pulse++) {                 // 10 l/min on both channels
+            nativeRaiseInterrupt(0);
+            nativeRaiseInterrupt(1);
+        }
+
+        bank.update(1000);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(120000UL, bank.getTotalDuration());
+    TEST_ASSERT_EQUAL_UINT32(120000UL, bank.getTotalDuration(0));
+    TEST_ASSERT_EQUAL_UINT32(60000UL, bank.getTotalDuration(1));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 5.0, bank.getTotalFlowrate(0));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 10.0, bank.getTotalFlowrate(1));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0.0, bank.getTotalError(1));
+
+    bank.setTotalDuration(1, 1000)->setTotalDuration(5, 2000);
+    TEST_ASSERT_EQUAL_UINT32(1000UL, bank.getTotalDuration(1));
+    TEST_ASSERT_EQUAL_UINT32(0UL, bank.getTotalDuration(5));
+
+    bank.setTotalDuration(500);
+    TEST_ASSERT_EQUAL_UINT32(500UL, bank.getTotalDuration());
+    TEST_ASSERT_EQUAL_UINT32(500UL, bank.getTotalDuration(0));
+    TEST_ASSERT_EQUAL_UINT32(500UL, bank.getTotalDuration(1));
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_matches_meters);
+    RUN_TEST(test_channel_range);
+    RUN_TEST(test_late_attach);
+    return UNITY_END();
+}
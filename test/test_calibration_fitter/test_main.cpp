@@ -0,0 +1,156 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Tests of FlowCalibrationFitter on simulated reference runs (run with: pio test -e native).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <algorithm>
+#include <math.h>
+#include <random>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "FlowCalibrationFitter.h"
+#include "Injected.h"
+
+/**
+ * Simulates a sensor with the given (true) properties, i.e. the volume that its pulses at a pulse rate stand for (as FlowMeter models it,
+ * with the decile picked from the pulse rate).
+ */
+static double trueVolume(const FlowSensorProperties &properties, double frequency, double pulses) {
+    unsigned int decile = std::min(9u, (unsigned int) (10.0 * frequency / (properties.capacity * properties.kFactor)));
+    return pulses * properties.mFactor[decile] / (60.0 * properties.kFactor);   // V = p * m / (60 * K), see FlowMeter::update()
+}
+
+/**
+ * Fits a sensor from reference runs at random pulse rates (with 0.2 % noise on both the sensor and the reference),
+ * starting from a datasheet k-factor that is 5 % off (with the right pulse rate at capacity) and no meter factors.
+ * The volume per pulse of every decile has to be within 0.5 % and four standard errors of the truth, and an hour of varying flow
+ * metered with the fit within 0.5 %.
+ */
+static void fit(const FlowSensorProperties &truth, unsigned int runs) {
+    std::minstd_rand random(42);
+    std::uniform_real_distribution<double> share(0.02, 1.0), length(30000.0, 120000.0);   // pulse rate (of capacity), run duration (in ms)
+    std::normal_distribution<double> noise(1.0, 0.002);
+    double fullScale = truth.capacity * truth.kFactor;                      // pulse rate at capacity (in 1/s)
+    FlowSensorProperties datasheet = {truth.capacity / 1.05, truth.kFactor * 1.05, {1, 1, 1, 1, 1, 1, 1, 1, 1, 1}};
+    FlowCalibrationFitter fitter(datasheet);
+
+    for (unsigned int run = 0; run < runs; run++) {
+        double frequency = share(random) * fullScale;
+        unsigned long duration = length(random);
+        double pulses = frequency * duration / 1000.0;
+        unsigned long counted = (unsigned long) (pulses * noise(random) + 0.5);
+
+        TEST_ASSERT_TRUE(fitter.addRun(counted, duration, trueVolume(truth, counted * 1000.0 / duration, pulses) * noise(random)));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(runs, fitter.getRunCount());
+
+    FlowSensorProperties fitted = fitter.getProperties();
+
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9 * fullScale, fullScale, fitted.capacity * fitted.kFactor);   // same deciles
+
+    for (uint8_t decile = 0; decile < 10; decile++) {
+        double deviation = (truth.kFactor / truth.mFactor[decile]) / (fitted.kFactor / fitted.mFactor[decile]) - 1.0;   // volume per pulse
+        double error = fitter.getMeterFactorError(decile) / fitted.mFactor[decile];
+
+        TEST_ASSERT_DOUBLE_WITHIN(0.005, 0.0, deviation);
+        TEST_ASSERT_DOUBLE_WITHIN(4.0 * error, 0.0, deviation);
+    }
+
+    Injected<FlowMeter> calibrated(2, datasheet);
+    std::uniform_real_distribution<double> level(0.05, 1.0);
+    double exact = 0.0, carry = 0.0, frequency = 0.0;
+
+    calibrated.setProperties(fitted);
+
+    for (unsigned long tick = 0; tick < 3600; tick++) {
+        if (tick % 60 == 0) {
+            frequency = level(random) * fullScale;                          // a new flow rate every minute
+        }
+
+        double due = frequency + carry;                                     // one second of flow
+        unsigned long pulses = (unsigned long) due;
+        carry = due - pulses;
+        exact += trueVolume(truth, pulses, pulses);
+
+        calibrated.inject(pulses);
+        calibrated.update(1000);
+    }
+
+    TEST_ASSERT_DOUBLE_WITHIN(0.005 * exact, exact, calibrated.getTotalVolume());
+}
+
+static void test_fs400a_cal(void) {
+    fit(FS400A_cal, 200);
+}
+
+static void test_fhkcs(void) {
+    fit(FHKCS_1mm_0deg, 200);
+    fit(FHKCS_1mm_0deg, 2000);
+}
+
+/**
+ * Empty runs are refused, and without runs the datasheet k-factor is kept.
+ */
+static void test_no_runs(void) {
+    FlowCalibrationFitter fitter(FS400A);
+
+    TEST_ASSERT_FALSE(fitter.addRun(0, 1000, 0.0));
+    TEST_ASSERT_EQUAL_UINT32(0, fitter.getRunCount());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, FS400A.kFactor, fitter.getKFactor());
+    TEST_ASSERT_TRUE(isnan(fitter.getKFactorError()));
+
+    fitter.addRun(4800, 60000, 1.0);
+    fitter.clear();
+
+    TEST_ASSERT_EQUAL_UINT32(0, fitter.getRunCount());
+}
+
+/**
+ * A run whose reference flow rate lies in one decile but whose pulse rate lies in the next is fitted into the decile that
+ * FlowMeter applies to its pulse rate.
+ */
+static void test_binned_by_pulse_rate(void) {
+    FlowCalibrationFitter fitter(FS400A_cal);
+    double fullScale = FS400A_cal.capacity * FS400A_cal.kFactor;            // (in 1/s)
+    unsigned long pulses = (unsigned long) (0.501 * fullScale * 60.0);      // one minute just above the decile 4/5 boundary
+    double volume = pulses * FS400A_cal.mFactor[5] / (60.0 * FS400A_cal.kFactor);
+
+    TEST_ASSERT_LESS_THAN(0.5 * FS400A_cal.capacity, volume);               // the flow rate (in l/min) is still in decile 4
+    TEST_ASSERT_TRUE(fitter.addRun(pulses, 60000, volume));
+    TEST_ASSERT_EQUAL_UINT32(1, fitter.getRunCount(5));
+    TEST_ASSERT_EQUAL_UINT32(0, fitter.getRunCount(4));
+
+    Injected<FlowMeter> meter(2, fitter.getProperties());
+
+    meter.inject(pulses / 60);
+    meter.update(1000);
+
+    TEST_ASSERT_DOUBLE_WITHIN(1e-3, fitter.getProperties().mFactor[5], meter.getCurrentError() / 100.0 + 1.0);
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_fs400a_cal);
+    RUN_TEST(test_fhkcs);
+    RUN_TEST(test_no_runs);
+    RUN_TEST(test_binned_by_pulse_rate);
+    return UNITY_END();
+}
@@ -0,0 +1,159 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Tests of CaptureFlowMeter's period-based frequency estimation (run with: pio test -e native).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <math.h>
+#include <random>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "CaptureFlowMeter.h"
+
+/**
+ * Fires the given number of evenly spaced pulses within a one second tick (in simulated time), then updates the meters.
+ */
+static void tick(FlowMeter &counting, CaptureFlowMeter &capturing, unsigned long pulses) {
+    unsigned long start = micros();
+
+    for (unsigned long i = 1; i <= pulses; i++) {
+        nativeSetMicros(start + i * 1000000UL / (pulses + 1));
+        counting.count();
+        capturing.count();
+    }
+
+    nativeSetMicros(start + 1000000UL);
+    counting.update(1000);
+    capturing.update(1000);
+}
+
+/**
+ * Without a previous pulse (after construction, reset() or a long pause) the first pulse of the tick has to be buffered to be used,
+ * which takes the full pulse count rather than the 8-bit buffer positions (these wrap around every 256 pulses).
+ */
+static void test_first_tick(void) {
+    const unsigned long counts[] = {1, 2, 3, 4, 5, 100, 255, 256, 257, 258, 259, 260, 513, 516, 1000};
+
+    for (unsigned long pulses : counts) {
+        nativeSetMicros(0);
+        FlowMeter counting(2, FS300A);
+        CaptureFlowMeter capturing(2, FS300A);
+
+        tick(counting, capturing, pulses);
+
+        double expected = pulses > 1 && pulses <= CaptureFlowMeter::captureSize ? pulses + 1.0 : pulses;   // from the pulse period, or per tick
+
+        TEST_ASSERT_DOUBLE_WITHIN_MESSAGE(0.01 * expected, expected, capturing.getCurrentFrequency(), "first tick");
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9, counting.getTotalVolume(), capturing.getTotalVolume());
+    }
+}
+
+static void test_after_reset(void) {
+    nativeSetMicros(0);
+    FlowMeter counting(2, FS300A);
+    CaptureFlowMeter capturing(2, FS300A);
+
+    tick(counting, capturing, 10);
+    capturing.reset();
+    tick(counting, capturing, 258);
+
+    TEST_ASSERT_DOUBLE_WITHIN(2.58, 258.0, capturing.getCurrentFrequency());
+}
+
+static void test_after_long_pause(void) {
+    nativeSetMicros(0);
+    FlowMeter counting(2, FS300A);
+    CaptureFlowMeter capturing(2, FS300A);
+
+    tick(counting, capturing, 10);
+
+    for (unsigned int i = 0; i < 3601; i++) {
+        tick(counting, capturing, 0);                                       // more than an hour without pulses
+    }
+
+    tick(counting, capturing, 258);
+
+    TEST_ASSERT_DOUBLE_WITHIN(2.58, 258.0, capturing.getCurrentFrequency());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, counting.getTotalVolume(), capturing.getTotalVolume());
+}
+
+/**
+ * A jittered low-flow pulse train: the capturing meter's readings scatter less than the counting meter's, with the same totals.
+ */
+static void test_low_flow(void) {
+    FlowSensorProperties *sensors[] = {&FS300A, &FS400A, &FS400A_cal, &FHKCS_1mm_0deg};
+
+    for (FlowSensorProperties *sensor : sensors) {
+        double frequency = 0.03 * sensor->capacity * sensor->kFactor;
+        std::minstd_rand random(42);
+        std::uniform_real_distribution<double> jitter(0.95, 1.05);
+
+        nativeSetMicros(0);
+        FlowMeter counting(2, *sensor);
+        CaptureFlowMeter capturing(2, *sensor);
+
+        unsigned long next = (unsigned long) (1e6 / frequency);             // time of the next pulse (in us)
+        double sum[2] = {0.0, 0.0}, squares[2] = {0.0, 0.0};
+        unsigned int samples = 0;
+
+        for (unsigned int tick = 1; tick <= 600; tick++) {
+            unsigned long end = tick * 1000000UL;
+
+            for (; next < end; next += (unsigned long) (1e6 / frequency * jitter(random))) {
+                nativeSetMicros(next);
+                counting.count();
+                capturing.count();
+            }
+
+            nativeSetMicros(end);
+            counting.update(1000);
+            capturing.update(1000);
+
+            if (tick > 10) {                                                // skip the warm-up
+                double readings[2] = {counting.getCurrentFlowrate(), capturing.getCurrentFlowrate()};
+
+                for (unsigned int i = 0; i < 2; i++) {
+                    sum[i] += readings[i];
+                    squares[i] += readings[i] * readings[i];
+                }
+                samples++;
+            }
+        }
+
+        double deviation[2];
+
+        for (unsigned int i = 0; i < 2; i++) {
+            double mean = sum[i] / samples;
+            deviation[i] = sqrt(fmax(0.0, squares[i] / samples - mean * mean)) / mean;
+        }
+
+        TEST_ASSERT_LESS_THAN(deviation[0], deviation[1]);
+        TEST_ASSERT_DOUBLE_WITHIN(0.05 * frequency / sensor->kFactor, sum[0] / samples, sum[1] / samples);
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9, counting.getTotalVolume(), capturing.getTotalVolume());
+    }
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_first_tick);
+    RUN_TEST(test_after_reset);
+    RUN_TEST(test_after_long_pause);
+    RUN_TEST(test_low_flow);
+    return UNITY_END();
+}
@@ -0,0 +1,124 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Stress tests of sampling the pulse counter and of volume targets while another thread counts (run with: pio test -e native).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <atomic>
+#include <thread>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "FixedFlowMeter.h"
+
+/**
+ * Fires count() from a second thread while update() samples the counter, and checks that every pulse is seen exactly once.
+ */
+template <class Meter>
+static void concurrency() {
+    const unsigned long total = 5000000;                                    // pulses fired by the counting thread
+    Meter meter(2, UncalibratedSensor);
+    std::atomic<bool> done(false);
+    unsigned long long seen = 0;
+    unsigned long updates = 0;
+
+    std::thread counter([&]() {
+        for (unsigned long i = 0; i < total; i++) {
+            meter.count();
+        }
+        done = true;
+    });
+
+    while (!done) {
+        meter.update(1000);                                                 // with 1000ms ticks the frequency equals the pulses of the tick
+        seen += (unsigned long long) meter.getCurrentFrequency();
+        updates++;
+    }
+
+    counter.join();
+    meter.update(1000);
+    seen += (unsigned long long) meter.getCurrentFrequency();
+
+    TEST_ASSERT_GREATER_THAN(1UL, updates);                                 // the threads actually overlapped
+    TEST_ASSERT_EQUAL_UINT64(total, seen);
+}
+
+static std::atomic<unsigned long> callbacks(0);                              // targets reached in targets()
+
+static void targetCallback() {
+    callbacks++;
+}
+
+/**
+ * Arms and clears volume targets while a second thread counts, as with a FlowEventPulseSource's reader calling count().
+ * Every other target is waited for, the others are cleared right away: a cleared target must stay cleared (rather than be
+ * counted past zero), and no target may call back more than once.
+ */
+static void test_targets(void) {
+    FlowMeter meter(2, UncalibratedSensor);
+    std::atomic<bool> done(false);
+    unsigned long armed = 0, waited = 0;
+
+    callbacks = 0;
+
+    std::thread counter([&]() {
+        while (!done) {
+            meter.count();
+        }
+    });
+
+    for (unsigned int i = 0; i < 20000; i++) {
+        meter.setTarget(1.0, targetCallback);
+        armed++;
+
+        TEST_ASSERT_LESS_OR_EQUAL(300UL, meter.getTargetPulses());          // 300 pulses per l (5 pulses/s per l/min)
+
+        if (i % 2 == 0) {
+            while (!meter.isTargetReached()) {
+                std::this_thread::yield();
+            }
+            waited++;
+        } else {
+            meter.clearTarget();
+            TEST_ASSERT_EQUAL_UINT32(0, meter.getTargetPulses());
+        }
+    }
+
+    done = true;
+    counter.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, meter.getTargetPulses());
+    TEST_ASSERT_GREATER_OR_EQUAL(waited, callbacks.load());
+    TEST_ASSERT_LESS_OR_EQUAL(armed, callbacks.load());
+}
+
+static void test_flow_meter(void) {
+    concurrency<FlowMeter>();
+}
+
+static void test_fixed_flow_meter(void) {
+    concurrency<FixedFlowMeter>();
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_flow_meter);
+    RUN_TEST(test_fixed_flow_meter);
+    RUN_TEST(test_targets);
+    return UNITY_END();
+}
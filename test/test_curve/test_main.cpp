@@ -0,0 +1,200 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Tests of calibration curves and their use in FlowMeter (run with: pio test -e native).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <random>
+#include <type_traits>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+
+static_assert(!std::is_constructible<FlowMeter, unsigned int, FlowSensorProperties, FlowCalibrationCurve>::value,
+              "a flow meter refers to its curve, so it can't take a temporary one");
+
+/**
+ * Runs a single one second tick at the given pulse rate, returns the meter factor that the meter applied.
+ */
+static double meterFactor(FlowMeter &meter, unsigned long frequency) {
+    for (unsigned long i = 0; i < frequency; i++) {
+        meter.count();
+    }
+
+    meter.update(1000);
+    return meter.getCurrentError() / 100.0 + 1.0;                           // error (in %) = (m-factor - 1) * 100
+}
+
+/**
+ * Closely spaced points (2 Hz apart, on a sensor with a range of 533 Hz) are reproduced exactly.
+ */
+static void test_close_points(void) {
+    FlowCalibrationCurve curve;
+    curve.addPoint(5.0, 1.10)->addPoint(7.0, 1.00);
+
+    FlowMeter meter(2, FS400A, curve);
+
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1.10, meterFactor(meter, 5));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1.05, meterFactor(meter, 6));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1.00, meterFactor(meter, 7));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1.10, meterFactor(meter, 1));   // constant beyond the outer points
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1.00, meterFactor(meter, 300));
+}
+
+/**
+ * The meter follows the curve's own interpolation at every pulse rate, with the points added in any order.
+ */
+static void test_follows_curve(void) {
+    FlowCalibrationCurve curve;
+    const double points[][2] = {{120.0, 0.99}, {5.0, 1.02}, {40.0, 1.0}, {6.5, 1.05}, {300.0, 0.97}, {41.0, 0.95}, {0.5, 1.2}};
+
+    for (const double *point : points) {
+        curve.addPoint(point[0], point[1]);
+    }
+
+    for (uint8_t i = 1; i < curve.getPointCount(); i++) {
+        TEST_ASSERT_TRUE(curve.getPoint(i - 1).frequency <= curve.getPoint(i).frequency);
+    }
+
+    FlowMeter meter(2, FS400A, curve);
+
+    for (unsigned long frequency = 0; frequency < 600; frequency++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-6, curve.getMeterFactor(frequency), meterFactor(meter, frequency));
+    }
+}
+
+/**
+ * A curve through the decile centres agrees with the deciles at their centres.
+ */
+static void test_from_properties(void) {
+    FlowCalibrationCurve curve(FS400A_cal);
+    double width = FS400A_cal.capacity * FS400A_cal.kFactor / 10.0;
+
+    TEST_ASSERT_EQUAL_UINT8(10, curve.getPointCount());
+
+    for (unsigned int decile = 0; decile < 10; decile++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-6, FS400A_cal.mFactor[decile], curve.getMeterFactor((decile + 0.5) * width));
+    }
+}
+
+static void test_empty_curve(void) {
+    FlowCalibrationCurve curve;
+    FlowMeter curved(2, FS400A_cal, curve);
+    FlowMeter deciles(2, FS400A_cal);
+
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 1.0, curve.getMeterFactor(10.0));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, meterFactor(deciles, 100), meterFactor(curved, 100));   // the deciles apply
+}
+
+static void test_full_curve(void) {
+    FlowCalibrationCurve curve;
+
+    for (uint8_t i = 0; i < FlowCalibrationCurve::maxPoints + 2; i++) {
+        curve.addPoint(i, 1.0);
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(FlowCalibrationCurve::maxPoints, curve.getPointCount());
+}
+
+/**
+ * Interpolates along the points by scanning all of them, as a reference for the indexed lookup.
+ */
+static double scan(const FlowCalibrationCurve &curve, double frequency) {
+    uint8_t last = curve.getPointCount() - 1;
+
+    if (frequency <= curve.getPoint(0).frequency) return curve.getPoint(0).mFactor;
+    if (frequency >= curve.getPoint(last).frequency) return curve.getPoint(last).mFactor;
+
+    uint8_t lower = 0;
+
+    while (curve.getPoint(lower + 1).frequency <= frequency) {
+        lower++;
+    }
+
+    FlowCalibrationPoint below = curve.getPoint(lower), above = curve.getPoint(lower + 1);
+    return below.mFactor + (frequency - below.frequency) * (above.mFactor - below.mFactor) / (above.frequency - below.frequency);
+}
+
+/**
+ * The indexed lookup matches a scan over all points, for full curves with clusters of points within one cell, repeated
+ * frequencies and points on cell boundaries, and is exact at every point.
+ */
+static void test_index(void) {
+    std::minstd_rand random(42);
+    std::uniform_real_distribution<double> spread(0.0, 500.0), cluster(0.0, 0.5), factor(0.9, 1.1);
+
+    for (unsigned int round = 0; round < 200; round++) {
+        FlowCalibrationCurve curve;
+        double centre = spread(random);
+
+        for (uint8_t i = 0; i < FlowCalibrationCurve::maxPoints; i++) {
+            double frequency = i % 3 == 0 ? spread(random) : i % 3 == 1 ? centre + cluster(random) : curve.getPoint(0).frequency;
+            curve.addPoint(round % 2 ? frequency : (double) (unsigned long) frequency, factor(random));
+        }
+
+        for (uint8_t i = 0; i < curve.getPointCount(); i++) {
+            FlowCalibrationPoint point = curve.getPoint(i);
+
+            bool repeated = (i > 0 && curve.getPoint(i - 1).frequency == point.frequency) ||
+                            (i + 1 < curve.getPointCount() && curve.getPoint(i + 1).frequency == point.frequency);
+
+            if (!repeated) {
+                TEST_ASSERT_EQUAL_DOUBLE(point.mFactor, curve.getMeterFactor(point.frequency));
+            }
+        }
+
+        for (double frequency = 0.0; frequency < 520.0; frequency += 0.0625) {
+            TEST_ASSERT_DOUBLE_WITHIN(1e-12, scan(curve, frequency), curve.getMeterFactor(frequency));
+        }
+    }
+}
+
+/**
+ * Flow meters (with a curve or without) can be copied, copies refer to the same curve.
+ */
+static void test_copy(void) {
+    FlowCalibrationCurve curve;
+    curve.addPoint(5.0, 1.10)->addPoint(7.0, 1.00);
+
+    FlowMeter plain = FlowMeter(2, FS400A);
+    FlowMeter *original = new FlowMeter(2, FS400A, curve);
+    FlowMeter copy = *original;
+
+    delete original;
+    plain = copy;
+
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1.05, meterFactor(copy, 6));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1.05, meterFactor(plain, 6));
+
+    plain.setProperties(FS400A);                                            // back to deciles, the copy keeps its curve
+
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, FS400A.mFactor[0], meterFactor(plain, 6));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1.05, meterFactor(copy, 6));
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_close_points);
+    RUN_TEST(test_follows_curve);
+    RUN_TEST(test_from_properties);
+    RUN_TEST(test_empty_curve);
+    RUN_TEST(test_full_curve);
+    RUN_TEST(test_index);
+    RUN_TEST(test_copy);
+    return UNITY_END();
+}
@@ -0,0 +1,141 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Tests of pulse debouncing on noisy pulse trains (run with: pio test -e native).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <algorithm>
+#include <math.h>
+#include <random>
+#include <vector>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "CaptureFlowMeter.h"
+
+/**
+ * Plays ten minutes of pulses (at the given share of capacity, with 10 % jitter) in simulated time, with noise on top:
+ * ringing (each edge followed by a few spurious edges within 800 us, with the given probability) and random spikes (at the given rate, per s).
+ * Debouncing (setDebounce() with its default margin) has to count the real pulses within the given error (in %), and every edge
+ * has to be either counted or rejected.
+ */
+template <class Meter>
+static void debounce(FlowSensorProperties &properties, double share, double ringing, double spikes, double bound) {
+    const unsigned long long duration = 600000000ULL;                       // (in us)
+    std::minstd_rand random(42);
+    std::uniform_real_distribution<double> jitter(0.9, 1.1), after(20.0, 800.0);
+    std::bernoulli_distribution rings(ringing);
+    std::uniform_int_distribution<int> echoes(1, 3);
+    std::vector<unsigned long long> edges;
+    double interval = 1e6 / (share * properties.capacity * properties.kFactor);   // (in us)
+    unsigned long pulses = 0;
+
+    for (double time = interval; time < duration; time += interval * jitter(random)) {
+        edges.push_back((unsigned long long) time);
+        pulses++;
+
+        for (int echo = rings(random) ? echoes(random) : 0; echo > 0; echo--) {
+            edges.push_back((unsigned long long) (time + after(random)));
+        }
+    }
+
+    if (spikes > 0.0) {
+        std::exponential_distribution<double> gap(spikes / 1e6);
+
+        for (double time = gap(random); time < duration; time += gap(random)) {
+            edges.push_back((unsigned long long) time);
+        }
+    }
+
+    std::sort(edges.begin(), edges.end());
+
+    nativeSetMicros(0);
+    Meter meter(2, properties);
+    meter.setDebounce();
+
+    for (unsigned long long edge : edges) {
+        nativeSetMicros(edge);
+        meter.count();
+    }
+
+    meter.update(duration / 1000);
+
+    double error = ((double) meter.getTotalPulses() - pulses) / pulses * 100.0;
+
+    TEST_ASSERT_DOUBLE_WITHIN(bound, 0.0, error);
+    TEST_ASSERT_EQUAL_UINT32(edges.size(), meter.getTotalPulses() + meter.getRejectedPulses());
+}
+
+static void test_clean(void) {
+    debounce<FlowMeter>(FS400A, 1.0, 0.0, 0.0, 0.0);                        // at capacity, nothing may be lost
+    debounce<CaptureFlowMeter>(FS400A, 1.0, 0.0, 0.0, 0.0);
+}
+
+static void test_ringing(void) {
+    debounce<FlowMeter>(FS400A, 0.5, 0.3, 0.0, 0.0);
+    debounce<FlowMeter>(FHKCS_1mm_0deg, 0.8, 0.5, 2.0, 1.0);
+    debounce<CaptureFlowMeter>(FS400A, 0.5, 0.3, 0.0, 0.0);
+}
+
+static void test_spikes(void) {
+    debounce<FlowMeter>(FS400A, 0.5, 0.0, 20.0, 5.0);                       // spikes far from any pulse look like pulses to a minimum interval
+    debounce<FlowMeter>(FS400A, 0.8, 0.3, 20.0, 1.0);
+}
+
+/**
+ * The interval follows from capacity * kFactor * (1 + margin), and is off by default.
+ */
+static void test_interval(void) {
+    FlowMeter meter(2, FS400A);                                             // 60 l/min at 4.8 pulses/s per l/min
+
+    TEST_ASSERT_EQUAL_UINT32(0, meter.getDebounceInterval());
+    meter.setDebounce();
+    TEST_ASSERT_EQUAL_UINT32(2314, meter.getDebounceInterval());            // 1e6 / (288 * 1.5)
+    meter.setDebounce(0.0);
+    TEST_ASSERT_EQUAL_UINT32(3472, meter.getDebounceInterval());
+    meter.setDebounceInterval(0);
+    TEST_ASSERT_EQUAL_UINT32(0, meter.getDebounceInterval());
+}
+
+/**
+ * Without debouncing, every edge counts.
+ */
+static void test_off(void) {
+    nativeSetMicros(0);
+    FlowMeter meter(2, FS400A);
+
+    for (unsigned int i = 0; i < 100; i++) {
+        nativeAdvanceMicros(10);
+        meter.count();
+    }
+
+    meter.update(1000);
+
+    TEST_ASSERT_EQUAL_UINT32(100, meter.getTotalPulses());
+    TEST_ASSERT_EQUAL_UINT32(0, meter.getRejectedPulses());
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_clean);
+    RUN_TEST(test_ringing);
+    RUN_TEST(test_spikes);
+    RUN_TEST(test_interval);
+    RUN_TEST(test_off);
+    return UNITY_END();
+}
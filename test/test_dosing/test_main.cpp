@@ -0,0 +1,147 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Tests of volume targets (run with: pio test -e native).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <algorithm>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "FlowSimulatedPulseSource.h"
+
+static unsigned long fired;                                                 // pulses fired so far
+static unsigned long reached;                                               // pulse that reached the target
+static unsigned int calls;                                                  // callback calls
+
+static void callback() {
+    reached = fired;
+    calls++;
+}
+
+/**
+ * Doses a volume at a steady flow rate, and checks that the target fires once, with the pulse that completes the volume.
+ */
+static void dose(FlowSensorProperties &properties, double flowrate, double volume) {
+    unsigned int decile = std::min(9u, (unsigned int) (10.0 * flowrate / properties.capacity));
+    double frequency = flowrate * properties.kFactor / properties.mFactor[decile];  // sensor model, see FlowFleet
+    double perPulse = 1.0 / (60.0 * properties.kFactor / properties.mFactor[decile]);   // volume per pulse (in l)
+    double exact = volume / perPulse;                                       // pulses that make up the volume
+    FlowMeter meter(2, properties);
+    double carry = 0.0;
+
+    for (unsigned long i = 0; i < (unsigned long) (frequency + 0.5); i++) meter.count();
+    meter.update(1000);                                                     // one tick of flow, so that the target uses its correction
+
+    fired = reached = calls = 0;
+    meter.setTarget(volume, callback);
+
+    TEST_ASSERT_FALSE(meter.isTargetReached());
+    TEST_ASSERT_DOUBLE_WITHIN(0.5, exact, (double) meter.getTargetPulses());
+
+    while (fired < 2 * exact) {
+        double due = frequency + carry;
+        unsigned long pulses = (unsigned long) due;
+        carry = due - pulses;
+
+        for (unsigned long i = 0; i < pulses; i++) {
+            fired++;
+            meter.count();
+        }
+
+        meter.update(1000);
+    }
+
+    TEST_ASSERT_TRUE(meter.isTargetReached());
+    TEST_ASSERT_EQUAL_UINT(1, calls);
+    TEST_ASSERT_DOUBLE_WITHIN(0.5, exact, (double) reached);
+    TEST_ASSERT_EQUAL_UINT32(0, meter.getTargetPulses());
+}
+
+static void test_dose(void) {
+    dose(FS400A_cal, 10.0, 1.0);
+    dose(FS400A_cal, 25.0, 1.0);
+    dose(FHKCS_1mm_0deg, 0.3, 1.0);
+}
+
+static void test_idle_meter(void) {
+    FlowMeter meter(2, FS400A);
+
+    meter.setTarget(1.0);                                                   // no flow yet: assumes mid-range flow, i.e. the sixth decile
+
+    TEST_ASSERT_DOUBLE_WITHIN(0.5, 60.0 * FS400A.kFactor / FS400A.mFactor[5], (double) meter.getTargetPulses());
+}
+
+static void test_clear(void) {
+    FlowMeter meter(2, FS400A);
+
+    calls = 0;
+    meter.setTarget(0.01, callback);
+    meter.clearTarget();
+
+    for (unsigned int i = 0; i < 1000; i++) meter.count();
+
+    TEST_ASSERT_FALSE(meter.isTargetReached());
+    TEST_ASSERT_EQUAL_UINT(0, calls);
+    TEST_ASSERT_EQUAL_UINT32(0, meter.getTargetPulses());
+}
+
+static void test_nothing_to_wait_for(void) {
+    FlowMeter meter(2, FS400A);
+
+    calls = 0;
+    meter.setTarget(0.0, callback);
+
+    TEST_ASSERT_TRUE(meter.isTargetReached());
+    TEST_ASSERT_EQUAL_UINT(1, calls);
+}
+
+/**
+ * With a pulse source, the target is checked once per tick.
+ */
+static void test_pulse_source(void) {
+    nativeSetMicros(0);
+    FlowSimulatedPulseSource source(100.0);
+    FlowMeter meter(2, FS400A);
+
+    meter.setPulseSource(&source);
+    nativeAdvanceMicros(1000000);
+    meter.update(1000);
+
+    calls = 0;
+    meter.setTarget(250.0 / (60.0 * FS400A.kFactor / FS400A.mFactor[1]), callback);   // 250 pulses at 100 Hz
+
+    for (unsigned int tick = 1; tick <= 3; tick++) {
+        nativeAdvanceMicros(1000000);
+        meter.update(1000);
+
+        TEST_ASSERT_EQUAL(tick == 3, meter.isTargetReached());
+    }
+
+    TEST_ASSERT_EQUAL_UINT(1, calls);
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_dose);
+    RUN_TEST(test_idle_meter);
+    RUN_TEST(test_clear);
+    RUN_TEST(test_nothing_to_wait_for);
+    RUN_TEST(test_pulse_source);
+    return UNITY_END();
+}
@@ -0,0 +1,149 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Differential test of FixedFlowMeter against FlowMeter (run with: pio test -e native).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <math.h>
+#include <random>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "FixedFlowMeter.h"
+#include "Injected.h"
+
+static const unsigned int ticks = 4096;
+
+static FlowSensorProperties Distinct = {30.0f, 5.2f, {0.95, 0.96, 0.97, 0.98, 0.99, 1.0, 1.01, 1.02, 1.03, 1.04}};   // a wrong decile always shows
+
+static FlowSensorProperties *sensors[] = {&UncalibratedSensor, &FS300A, &FS400A, &FS400A_cal, &FHKCS_1mm_0deg, &Distinct};
+
+/**
+ * Runs the fixed-point engine alongside the floating point one and checks the error bounds stated in FixedFlowMeter.h
+ * against exact arithmetic: the decile is computed exactly, and so is the volume it implies.
+ * Only ticks within i * 2^-17 Hz of the i-th decile boundary may pick the neighbouring decile, then only the fixed-point total
+ * is followed. Any other disagreement fails, as does FlowMeter picking another decile (beyond the rounding of its float product
+ * capacity * kFactor).
+ */
+template <class Distribution>
+static void differential(FlowSensorProperties &properties, Distribution distribution) {
+    std::minstd_rand random(42);
+    Injected<FlowMeter> reference(2, properties);
+    Injected<FixedFlowMeter> fixed(2, properties);
+    long double width = (long double) properties.capacity * properties.kFactor / 10.0L;   // exact decile width (in 1/s)
+    long double exactTotal = 0.0;                                           // exact total volume (in l)
+    double bound = 0.0;                                                     // accumulated volume bound (in l)
+    unsigned long checked = 0;
+
+    for (unsigned int i = 0; i < ticks; i++) {
+        unsigned long pulses = distribution(random);
+        unsigned long duration = 1000 + i % 7;                              // vary the tick slightly
+
+        reference.inject(pulses);
+        fixed.inject(pulses);
+        reference.update(duration);
+        fixed.update(duration);
+
+        long double frequency = pulses * 1000.0L / duration;                // (in 1/s)
+        unsigned int decile = 0;
+        bool ambiguous = false, inexact = false;
+
+        for (unsigned int boundary = 1; boundary <= 9; boundary++) {
+            long double distance = fabsl(frequency - boundary * width);
+
+            decile += frequency >= boundary * width;
+            ambiguous = ambiguous || distance <= boundary * ldexp(1.0, -17) + 1e-12L;   // Q16.16 decile width, see FixedFlowMeter.h
+            inexact = inexact || distance <= boundary * width * ldexp(1.0, -23);       // float product in FlowMeter::correction()
+        }
+
+        if (!inexact) {
+            TEST_ASSERT_DOUBLE_WITHIN(1e-9, properties.mFactor[decile], reference.getCurrentError() / 100.0 + 1.0);
+        }
+
+        if (ambiguous) {
+            exactTotal += fixed.getCurrentVolume();                         // decile boundary, both results are valid
+            continue;
+        }
+
+        double correction = properties.kFactor / (fixed.getCurrentError() / 100.0 + 1.0);    // error (in %) = (K / correction - 1) * 100
+        long double exact = pulses * (long double) properties.mFactor[decile] / (60.0L * properties.kFactor);
+        double tickBound = pulses * 0.5e-9 + 1e-15;                         // 0.5 nl per pulse, plus floating point noise
+
+        TEST_ASSERT_DOUBLE_WITHIN(ldexp(1.0, -17) + 1e-12, properties.kFactor / properties.mFactor[decile], correction);
+        TEST_ASSERT_DOUBLE_WITHIN(tickBound, (double) exact, fixed.getCurrentVolume());
+
+        exactTotal += exact;
+        bound += tickBound;
+        checked++;
+    }
+
+    TEST_ASSERT_GREATER_THAN(ticks / 2, checked);                           // boundary ticks stay the exception
+    TEST_ASSERT_DOUBLE_WITHIN(bound + 1e-12, (double) exactTotal, fixed.getTotalVolume());
+    TEST_ASSERT_EQUAL_UINT64(reference.getTotalDuration64(), fixed.getTotalDuration64());
+}
+
+static void test_idle(void) {
+    for (FlowSensorProperties *sensor : sensors) {
+        differential(*sensor, [](std::minstd_rand &) { return 0UL; });
+    }
+}
+
+static void test_trickle(void) {
+    for (FlowSensorProperties *sensor : sensors) {
+        std::poisson_distribution<unsigned long> flow(0.02 * sensor->capacity * sensor->kFactor + 0.5);
+        differential(*sensor, [&](std::minstd_rand &random) { return flow(random); });
+    }
+}
+
+static void test_uniform(void) {
+    for (FlowSensorProperties *sensor : sensors) {
+        std::uniform_int_distribution<unsigned long> flow(0, (unsigned long) (sensor->capacity * sensor->kFactor));
+        differential(*sensor, [&](std::minstd_rand &random) { return flow(random); });
+    }
+}
+
+static void test_beyond_capacity(void) {
+    for (FlowSensorProperties *sensor : sensors) {
+        std::uniform_int_distribution<unsigned long> flow((unsigned long) (sensor->capacity * sensor->kFactor), (unsigned long) (2.0 * sensor->capacity * sensor->kFactor));
+        differential(*sensor, [&](std::minstd_rand &random) { return flow(random); });
+    }
+}
+
+/**
+ * Pulse counts right at the decile boundaries (for the 1000 ms ticks), so that the Q16.16 decile width decides some of them:
+ * with 30 l/min at 5.2 pulses/s per l/min (as floats), 78 pulses/s lie 2.9e-6 Hz above the exact boundary between decile 4 and 5,
+ * but below the rounded one.
+ */
+static void test_boundaries(void) {
+    for (FlowSensorProperties *sensor : sensors) {
+        std::uniform_int_distribution<unsigned int> boundary(1, 9);
+        std::uniform_int_distribution<int> offset(-1, 1);
+        double width = sensor->capacity * sensor->kFactor / 10.0;
+        differential(*sensor, [&](std::minstd_rand &random) { return (unsigned long) (lround(boundary(random) * width) + offset(random)); });
+    }
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_idle);
+    RUN_TEST(test_trickle);
+    RUN_TEST(test_uniform);
+    RUN_TEST(test_beyond_capacity);
+    RUN_TEST(test_boundaries);
+    return UNITY_END();
+}
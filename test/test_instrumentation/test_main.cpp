@@ -0,0 +1,134 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Tests of the instrumentation counters (run with: pio test -e native_instrumented, which defines FLOWMETER_INSTRUMENTATION).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "CaptureFlowMeter.h"
+
+#if !defined(FLOWMETER_INSTRUMENTATION)
+#error "the instrumentation tests need FLOWMETER_INSTRUMENTATION, run them with: pio test -e native_instrumented"
+#endif
+
+/**
+ * Plays a pulse train in simulated time: per tick the number of pulses, their interval (in us) and the tick length (in us).
+ */
+static void play(FlowMeter &meter, const unsigned long (*train)[3], unsigned int ticks) {
+    for (unsigned int i = 0; i < ticks; i++) {
+        for (unsigned long pulse = 0; pulse < train[i][0]; pulse++) {
+            nativeAdvanceMicros(train[i][1]);
+            meter.count();
+        }
+
+        nativeAdvanceMicros(train[i][2] - train[i][0] * train[i][1]);
+        meter.update(1000);
+    }
+}
+
+/**
+ * One regular tick, one beyond capacity and one late.
+ */
+static void test_counters(void) {
+    const unsigned long train[3][3] = {{100, 10000, 1000000}, {200, 5000, 1000000}, {50, 20000, 1500000}};
+
+    nativeSetMicros(0);
+    FlowMeter meter(2, FS400A_cal);                                         // capacity is 127.5 pulses/s
+
+    play(meter, train, 3);
+
+    FlowInstrumentation counters = meter.getInstrumentation();
+
+    TEST_ASSERT_EQUAL_UINT32(350, counters.interrupts);
+    TEST_ASSERT_EQUAL_UINT32(3, counters.updates);
+    TEST_ASSERT_EQUAL_UINT32(5000, counters.minInterval);
+    TEST_ASSERT_EQUAL_UINT32(20000, counters.maxInterval);
+    TEST_ASSERT_EQUAL_UINT32(1, counters.overCapacity);
+    TEST_ASSERT_EQUAL_UINT32(1, counters.lateUpdates);
+    TEST_ASSERT_EQUAL_UINT32(0, counters.countMicros);                      // simulated time stands still within a call
+    TEST_ASSERT_EQUAL_UINT32(0, counters.updateMaxMicros);
+}
+
+static void test_clear(void) {
+    const unsigned long train[2][3] = {{10, 1000, 1000000}, {10, 2000, 1000000}};
+
+    nativeSetMicros(0);
+    FlowMeter meter(2, FS400A_cal);
+
+    play(meter, train, 1);
+    meter.clearInstrumentation();
+
+    FlowInstrumentation counters = meter.getInstrumentation();
+
+    TEST_ASSERT_EQUAL_UINT32(0, counters.interrupts);
+    TEST_ASSERT_EQUAL_UINT32(0, counters.updates);
+    TEST_ASSERT_EQUAL_UINT32((unsigned long) -1, counters.minInterval);
+
+    play(meter, train + 1, 1);
+    counters = meter.getInstrumentation();
+
+    TEST_ASSERT_EQUAL_UINT32(10, counters.interrupts);
+    TEST_ASSERT_EQUAL_UINT32(1, counters.updates);
+    TEST_ASSERT_EQUAL_UINT32(2000, counters.minInterval);                   // no interval across the restart
+    TEST_ASSERT_EQUAL_UINT32(2000, counters.maxInterval);
+    TEST_ASSERT_EQUAL_UINT32(0, counters.lateUpdates);
+}
+
+/**
+ * Every pulse rings once, 100 us later: each edge is an interrupt, the echoes are rejected by debouncing but still timed and counted.
+ */
+template <class Meter>
+static void debounced() {
+    nativeSetMicros(0);
+    Meter meter(2, FS400A_cal);
+
+    meter.setDebounceInterval(1000);
+
+    for (unsigned int pulse = 0; pulse < 10; pulse++) {
+        nativeAdvanceMicros(10000);
+        meter.count();
+        nativeAdvanceMicros(100);
+        meter.count();
+    }
+
+    nativeAdvanceMicros(1000000 - 10 * 10100);
+    meter.update(1000);
+
+    FlowInstrumentation counters = meter.getInstrumentation();
+
+    TEST_ASSERT_EQUAL_UINT32(20, counters.interrupts);
+    TEST_ASSERT_EQUAL_UINT32(10, meter.getRejectedPulses());
+    TEST_ASSERT_EQUAL_UINT32(10, meter.getTotalPulses());
+    TEST_ASSERT_EQUAL_UINT32(100, counters.minInterval);
+    TEST_ASSERT_EQUAL_UINT32(10000, counters.maxInterval);
+}
+
+static void test_debounced(void) {
+    debounced<FlowMeter>();
+    debounced<CaptureFlowMeter>();
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_counters);
+    RUN_TEST(test_clear);
+    RUN_TEST(test_debounced);
+    return UNITY_END();
+}
@@ -0,0 +1,91 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Tests of the base meter, i.e. without any of the optional parts compiled in (run with: pio test -e native_lean).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <random>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "StaticFlowMeter.h"
+#include "Injected.h"
+
+#if defined(FLOWMETER_TOTALIZER) || defined(FLOWMETER_CURVES) || defined(FLOWMETER_TARGETS) || defined(FLOWMETER_HOOKS)
+#error "test_lean checks the base meter, build it without the optional parts"
+#endif
+
+/**
+ * The totals are the plain sums of the ticks, and setting them (or switching properties) carries on from the given values.
+ */
+template <class Meter>
+static void totals(Meter &meter) {
+    std::minstd_rand random(42);
+    std::uniform_int_distribution<unsigned long> flow(0, (unsigned long) (FS400A_cal.capacity * FS400A_cal.kFactor));
+    double volume = 0.0, correction = 0.0;
+
+    for (unsigned long tick = 0; tick < 3600; tick++) {
+        meter.inject(flow(random));
+        meter.update(1000);
+        volume += meter.getCurrentVolume();
+        correction += FS400A_cal.kFactor / (meter.getCurrentError() / 100.0 + 1.0) * 1000.0;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(3600000, meter.getTotalDuration());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9 * volume, volume, meter.getTotalVolume());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9 * correction, correction, meter.getTotalCorrection());
+
+    meter.setTotalVolume(10.0)->setTotalCorrection(0.0);
+    meter.inject(240);
+    meter.update(1000);
+
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 10.0 + meter.getCurrentVolume(), meter.getTotalVolume());
+    correction = FS400A_cal.kFactor / (meter.getCurrentError() / 100.0 + 1.0) * 1000.0;
+
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9 * correction, correction, meter.getTotalCorrection());
+}
+
+static void test_totals(void) {
+    Injected<FlowMeter> meter(2, FS400A_cal);
+    totals(meter);
+
+    double total = meter.getTotalVolume();
+    meter.setProperties(FS400A);
+
+    TEST_ASSERT_EQUAL_DOUBLE(total, meter.getTotalVolume());
+}
+
+static void test_static(void) {
+    Injected<StaticFlowMeter<FS400A_calTraits>> meter(2);
+    totals(meter);
+}
+
+/**
+ * Without the optional parts, the meter holds little more than its sensor properties and the current tick.
+ */
+static void test_size(void) {
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(FlowSensorProperties) + 18 * sizeof(double), sizeof(FlowMeter));
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_totals);
+    RUN_TEST(test_static);
+    RUN_TEST(test_size);
+    return UNITY_END();
+}
@@ -0,0 +1,123 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Tests of FlowMeter on an external pulse source (run with: pio test -e native).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <math.h>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "FlowSimulatedPulseSource.h"
+
+/**
+ * Runs a meter on a simulated counter for an hour of one second ticks, and checks that it sees every pulse.
+ */
+static void hour(FlowSensorProperties &properties, double share) {
+    const unsigned long seconds = 3600;
+    double frequency = properties.capacity * properties.kFactor * share;    // (in 1/s)
+
+    nativeSetMicros(0);
+    FlowSimulatedPulseSource source(frequency);
+    FlowMeter meter(2, properties);
+    double seen = 0.0;
+
+    meter.setPulseSource(&source);
+
+    for (unsigned long tick = 0; tick < seconds; tick++) {
+        nativeAdvanceMicros(1000000);
+        meter.update(1000);
+        seen += meter.getCurrentFrequency();
+
+        TEST_ASSERT_DOUBLE_WITHIN(1.0, frequency, meter.getCurrentFrequency());
+    }
+
+    TEST_ASSERT_DOUBLE_WITHIN(1.0, frequency * seconds, seen);
+    TEST_ASSERT_DOUBLE_WITHIN(1.0, frequency * seconds, (double) meter.getTotalPulses());
+}
+
+static void test_at_capacity(void) {
+    hour(FHKCS_1mm_0deg, 1.0);
+    hour(FS400A, 1.0);
+}
+
+static void test_beyond_interrupts(void) {
+    hour(FS400A, 10.0);                                                     // stands in for a larger sensor at thousands of Hz
+}
+
+/**
+ * Attaching a source (or going back to count()) starts from the current reading, without a jump.
+ */
+static void test_switching(void) {
+    nativeSetMicros(0);
+    FlowSimulatedPulseSource source(100.0);
+    FlowMeter meter(2, FS400A);
+
+    nativeAdvanceMicros(5000000);                                           // 500 pulses before the source is attached
+    meter.setPulseSource(&source);
+    nativeAdvanceMicros(1000000);
+    meter.update(1000);
+
+    TEST_ASSERT_DOUBLE_WITHIN(1.0, 100.0, meter.getCurrentFrequency());
+
+    meter.setPulseSource(NULL);
+
+    for (unsigned int i = 0; i < 7; i++) {
+        meter.count();
+    }
+
+    nativeAdvanceMicros(1000000);
+    meter.update(1000);
+
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 7.0, meter.getCurrentFrequency());     // only the counted pulses
+}
+
+/**
+ * A rate change shows in the next tick, and reset() skips the pulses so far.
+ */
+static void test_rate_change(void) {
+    nativeSetMicros(0);
+    FlowSimulatedPulseSource source(50.0);
+    FlowMeter meter(2, FS400A);
+
+    meter.setPulseSource(&source);
+    nativeAdvanceMicros(1000000);
+    meter.update(1000);
+    source.setFrequency(200.0);
+    nativeAdvanceMicros(1000000);
+    meter.update(1000);
+
+    TEST_ASSERT_DOUBLE_WITHIN(1.0, 200.0, meter.getCurrentFrequency());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 200.0, source.getFrequency());
+
+    nativeAdvanceMicros(3000000);
+    meter.reset();
+    nativeAdvanceMicros(1000000);
+    meter.update(1000);
+
+    TEST_ASSERT_DOUBLE_WITHIN(1.0, 200.0, meter.getCurrentFrequency());
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_at_capacity);
+    RUN_TEST(test_beyond_interrupts);
+    RUN_TEST(test_switching);
+    RUN_TEST(test_rate_change);
+    return UNITY_END();
+}
@@ -0,0 +1,228 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Tests of FlowReplay against meters fed directly (run with: pio test -e native).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <algorithm>
+#include <errno.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "FlowReplay.h"
+#include "Injected.h"
+
+/**
+ * Writes the given bytes to a fresh temporary file, whose path is returned in path (at least 32 chars).
+ */
+static void store(char *path, const void *data, size_t size) {
+    snprintf(path, 32, "/tmp/flowreplayXXXXXX");
+    int file = mkstemp(path);
+
+    TEST_ASSERT_TRUE(file >= 0);
+    TEST_ASSERT_EQUAL_UINT32(size, ::write(file, data, size));
+    close(file);
+}
+
+/**
+ * Tells whether the file at path is mapped into this process (see /proc/self/maps).
+ */
+static bool isMapped(const char *path) {
+    FILE *maps = fopen("/proc/self/maps", "r");
+    char line[512];
+    bool found = false;
+
+    while (maps != NULL && fgets(line, sizeof(line), maps) != NULL) {
+        found = found || strstr(line, path) != NULL;
+    }
+
+    if (maps != NULL) {
+        fclose(maps);
+    }
+
+    return found;
+}
+
+/**
+ * Records an hour of bursty pulses (with gaps of several empty ticks), starting mid-tick.
+ */
+static std::vector<uint64_t> record() {
+    std::minstd_rand random(42);
+    std::exponential_distribution<double> interval(1.0 / 8000.0), pause(1.0 / 20e6);   // (in us)
+    std::bernoulli_distribution pausing(0.001);
+    std::vector<uint64_t> timestamps;
+
+    for (double time = 1234567.0; time < 3600e6; time += pausing(random) ? pause(random) : interval(random)) {
+        timestamps.push_back((uint64_t) time);
+    }
+
+    return timestamps;
+}
+
+/**
+ * Feeds the timestamps to a meter tick by tick, as replaying them should (ticks aligned to multiples of the period,
+ * from the tick of the first pulse up to the tick of the last one).
+ */
+static void feed(Injected<FlowMeter> &meter, const std::vector<uint64_t> &timestamps, unsigned long period, double &peak) {
+    uint64_t length = period * 1000ULL;
+    uint64_t tick = timestamps.front() / length;
+    unsigned long pulses = 0;
+
+    peak = 0.0;
+
+    for (uint64_t timestamp : timestamps) {
+        for (; tick < timestamp / length; tick++) {
+            meter.inject(pulses);
+            meter.update(period);
+            peak = std::max(peak, meter.getCurrentFlowrate());
+            pulses = 0;
+        }
+
+        pulses++;
+    }
+
+    meter.inject(pulses);
+    meter.update(period);
+    peak = std::max(peak, meter.getCurrentFlowrate());
+}
+
+/**
+ * Replayed totals match a direct run of the same meter, per decile and along a calibration curve, for several periods.
+ */
+static void test_direct(void) {
+    std::vector<uint64_t> timestamps = record();
+    FlowCalibrationCurve curve(FS400A_cal);
+    FlowReplay replay;
+
+    replay.setPulses(timestamps.data(), timestamps.size());
+    replay.addCandidate(FS400A_cal)->addCandidate(FS400A_cal, curve);
+
+    for (unsigned long period : {250UL, 1000UL, 3000UL}) {
+        Injected<FlowMeter> decile(0, FS400A_cal), curved(0, FS400A_cal, curve);
+        double decilePeak, curvePeak;
+
+        replay.run(period);
+        feed(decile, timestamps, period, decilePeak);
+        feed(curved, timestamps, period, curvePeak);
+
+        TEST_ASSERT_EQUAL_UINT32(decile.getTotalDuration() / period, replay.getTickCount());
+        TEST_ASSERT_EQUAL_UINT32(decile.getTotalDuration(), replay.getResult(0).totalDuration);
+        TEST_ASSERT_EQUAL_DOUBLE(decile.getTotalVolume(), replay.getResult(0).totalVolume);
+        TEST_ASSERT_EQUAL_DOUBLE(decile.getTotalError(), replay.getResult(0).totalError);
+        TEST_ASSERT_EQUAL_DOUBLE(decilePeak, replay.getResult(0).peakFlowrate);
+        TEST_ASSERT_EQUAL_DOUBLE(curved.getTotalVolume(), replay.getResult(1).totalVolume);
+        TEST_ASSERT_EQUAL_DOUBLE(curvePeak, replay.getResult(1).peakFlowrate);
+    }
+}
+
+/**
+ * A pulse right at a tick boundary belongs to the tick that starts there, and empty ticks in between are replayed too.
+ */
+static void test_tick_boundaries(void) {
+    const uint64_t timestamps[] = {2000000, 2999999, 3000000, 3000001, 3999999, 7000000};
+    FlowReplay replay;
+
+    replay.setPulses(timestamps, 6);
+    replay.addCandidate(UncalibratedSensor);
+    replay.run(1000);
+
+    TEST_ASSERT_EQUAL_UINT32(6, replay.getTickCount());                     // 2 s up to 7 s, the last tick holds one pulse
+    TEST_ASSERT_EQUAL_UINT32(6000, replay.getResult(0).totalDuration);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 3.0 / UncalibratedSensor.kFactor, replay.getResult(0).peakFlowrate);   // 3 pulses in [3 s, 4 s)
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 6.0 / (60.0 * UncalibratedSensor.kFactor), replay.getResult(0).totalVolume);
+}
+
+/**
+ * An empty stream replays no ticks, a stream that isn't made of whole timestamps (or doesn't exist) isn't opened.
+ */
+static void test_empty_and_short(void) {
+    const uint64_t timestamps[] = {1000, 2000};
+    char path[32];
+    FlowReplay replay;
+
+    replay.addCandidate(UncalibratedSensor);
+
+    store(path, timestamps, 0);
+    TEST_ASSERT_TRUE(replay.open(path));
+    TEST_ASSERT_EQUAL_UINT32(0, replay.getPulseCount());
+    replay.run(1000);
+    TEST_ASSERT_EQUAL_UINT32(0, replay.getTickCount());
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, replay.getResult(0).totalVolume);
+    unlink(path);
+
+    store(path, timestamps, 5);                                             // shorter than one timestamp
+    errno = 0;
+    TEST_ASSERT_FALSE(replay.open(path));
+    TEST_ASSERT_EQUAL_INT(EINVAL, errno);
+    unlink(path);
+
+    store(path, timestamps, 12);                                            // one and a half timestamps
+    errno = 0;
+    TEST_ASSERT_FALSE(replay.open(path));
+    TEST_ASSERT_EQUAL_INT(EINVAL, errno);
+    unlink(path);
+
+    TEST_ASSERT_FALSE(replay.open(path));
+    TEST_ASSERT_EQUAL_INT(ENOENT, errno);
+}
+
+/**
+ * An opened stream replays like the same pulses in memory, and switching to pulses in memory releases it.
+ */
+static void test_open(void) {
+    std::vector<uint64_t> timestamps = record();
+    char path[32];
+    FlowReplay mapped, direct;
+
+    store(path, timestamps.data(), timestamps.size() * sizeof(uint64_t));
+    TEST_ASSERT_TRUE(mapped.open(path));
+    TEST_ASSERT_TRUE(isMapped(path));
+    unlink(path);
+
+    direct.setPulses(timestamps.data(), timestamps.size());
+    mapped.addCandidate(FS400A);
+    direct.addCandidate(FS400A);
+    mapped.run(1000);
+    direct.run(1000);
+
+    TEST_ASSERT_EQUAL_UINT32(timestamps.size(), mapped.getPulseCount());
+    TEST_ASSERT_EQUAL_UINT32(direct.getTickCount(), mapped.getTickCount());
+    TEST_ASSERT_EQUAL_DOUBLE(direct.getResult(0).totalVolume, mapped.getResult(0).totalVolume);
+
+    mapped.setPulses(timestamps.data(), 2);
+    mapped.run(1000);
+
+    TEST_ASSERT_FALSE(isMapped(path));
+    TEST_ASSERT_EQUAL_UINT32(2, mapped.getPulseCount());
+    TEST_ASSERT_EQUAL_DOUBLE(2.0 * FS400A.mFactor[0] / (60.0 * FS400A.kFactor), mapped.getResult(0).totalVolume);
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_direct);
+    RUN_TEST(test_tick_boundaries);
+    RUN_TEST(test_empty_and_short);
+    RUN_TEST(test_open);
+    return UNITY_END();
+}
@@ -0,0 +1,195 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Tests of FlowScheduler in simulated time (run with: pio test -e native).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <math.h>
+#include <random>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "CaptureFlowMeter.h"
+#include "FixedFlowMeter.h"
+#include "FlowScheduler.h"
+#include "FlowSimulatedPulseSource.h"
+
+static const unsigned long long day = 86400000ULL;                          // (in ms)
+static const unsigned long long rollover = (1ULL << 32) - 3600000ULL;       // an hour before millis() rolls over on the Arduino (in ms)
+
+/**
+ * Runs a meter on a steady pulse source for a day of busy loop() calls (with the odd stall), across the millis() rollover,
+ * and checks the average tick period, that the ticks account for every millisecond and that the average flow rate is right.
+ */
+static void day_of_ticks(double frequency, bool adaptive, unsigned long expected) {
+    std::minstd_rand random(42);
+    std::uniform_int_distribution<unsigned long> work(1, 20);               // loop work (in ms)
+    std::bernoulli_distribution stall(0.0002);                              // e.g. a blocking network request
+
+    nativeSetMicros(rollover * 1000ULL);
+    FlowSimulatedPulseSource source(frequency);
+    FlowMeter meter(2, UncalibratedSensor);
+    FlowScheduler<1> scheduler(1000);
+    unsigned long long periods = 0;
+    unsigned long ticks = 0;
+
+    meter.setPulseSource(&source);
+    scheduler.attach(meter);
+
+    if (adaptive) {
+        scheduler.setAdaptive(250, 10000, 100);
+    }
+
+    while (millis() - rollover < day) {
+        nativeAdvanceMicros((work(random) + (stall(random) ? 2500 : 0)) * 1000ULL);
+
+        if (scheduler.poll() > 0) {
+            TEST_ASSERT_GREATER_OR_EQUAL(adaptive ? 250 : 1000, scheduler.getPeriod(0));
+            TEST_ASSERT_LESS_OR_EQUAL(adaptive ? 10000 : 1000, scheduler.getPeriod(0));
+
+            periods += scheduler.getPeriod(0);
+            ticks++;
+        }
+    }
+
+    unsigned long long elapsed = millis() - rollover;                       // (in ms)
+    double flowrate = frequency / UncalibratedSensor.kFactor;               // true flow rate (in l/min)
+
+    TEST_ASSERT_DOUBLE_WITHIN(0.02 * expected, expected, (double) periods / ticks);
+    TEST_ASSERT_LESS_OR_EQUAL(elapsed, meter.getTotalDuration64());
+    TEST_ASSERT_LESS_OR_EQUAL(10000 + 2520, elapsed - meter.getTotalDuration64());    // up to the last tick, plus a stall and loop work
+    TEST_ASSERT_DOUBLE_WITHIN(1e-3 * flowrate, flowrate, meter.getTotalFlowrate());
+}
+
+static void test_fixed(void) {
+    day_of_ticks(50.0, false, 1000);
+}
+
+static void test_adaptive(void) {
+    day_of_ticks(50.0, true, 2000);                                         // 100 pulses at 50 Hz
+}
+
+static void test_adaptive_trickle(void) {
+    day_of_ticks(2.0, true, 10000);                                         // capped at the longest tick
+}
+
+/**
+ * Ticks are counted from the previous deadline, so a late poll() doesn't shift the schedule.
+ */
+static void test_drift_free(void) {
+    nativeSetMicros(0);
+    FlowMeter meter(2, UncalibratedSensor);
+    FlowScheduler<1> scheduler(1000);
+
+    scheduler.attach(meter);
+
+    nativeSetMicros(1300000);                                               // 300 ms late
+    TEST_ASSERT_EQUAL_UINT8(1, scheduler.poll());
+    TEST_ASSERT_EQUAL_UINT32(1300, meter.getCurrentDuration());             // the true duration
+
+    nativeSetMicros(1999000);
+    TEST_ASSERT_EQUAL_UINT8(0, scheduler.poll());
+
+    nativeSetMicros(2000000);                                               // due at 2000 ms, not 2300 ms
+    TEST_ASSERT_EQUAL_UINT8(1, scheduler.poll());
+    TEST_ASSERT_EQUAL_UINT32(700, meter.getCurrentDuration());
+
+    nativeSetMicros(5500000);                                               // more than a period late: restart from now
+    TEST_ASSERT_EQUAL_UINT8(1, scheduler.poll());
+    nativeSetMicros(6000000);
+    TEST_ASSERT_EQUAL_UINT8(0, scheduler.poll());
+    nativeSetMicros(6500000);
+    TEST_ASSERT_EQUAL_UINT8(1, scheduler.poll());
+}
+
+/**
+ * Meters of different types share a scheduler, and each is updated by its own update(): evenly spaced pulses at 4 Hz
+ * show as 3 pulses per tick to a counting meter, but as 4 Hz to a capturing one.
+ */
+static void test_meter_types(void) {
+    nativeSetMicros(0);
+    FlowMeter counting(2, FS300A);
+    CaptureFlowMeter capturing(3, FS300A);
+    FixedFlowMeter fixed(4, FS300A);
+    FlowScheduler<3> scheduler(1000);
+
+    scheduler.attach(counting)->attach(capturing)->attach(fixed);
+    scheduler.attach(counting);                                             // full: ignored
+
+    TEST_ASSERT_EQUAL_UINT8(3, scheduler.getMeterCount());
+
+    for (unsigned long pulse = 1; pulse <= 3; pulse++) {
+        nativeSetMicros(pulse * 250000);
+        counting.count();
+        capturing.count();
+        fixed.count();
+    }
+
+    nativeSetMicros(1000000);
+
+    TEST_ASSERT_EQUAL_UINT8(3, scheduler.poll());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 3.0, counting.getCurrentFrequency());
+    TEST_ASSERT_DOUBLE_WITHIN(0.04, 4.0, capturing.getCurrentFrequency());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-3, 3.0, fixed.getCurrentFrequency());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, counting.getTotalVolume(), capturing.getTotalVolume());
+}
+
+/**
+ * Degenerate settings are clamped: a zero period would update(0), and adaptive ticks for zero pulses would take 0 / 0 ms without flow.
+ */
+static void test_degenerate(void) {
+    nativeSetMicros(0);
+    FlowMeter meter(2, UncalibratedSensor);
+    FlowScheduler<1> scheduler(0);
+
+    scheduler.attach(meter);
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.getPeriod(0));
+
+    for (unsigned int tick = 1; tick <= 10; tick++) {
+        nativeSetMicros(tick * 1000);
+        TEST_ASSERT_EQUAL_UINT8(1, scheduler.poll());
+        TEST_ASSERT_EQUAL_UINT32(1, meter.getCurrentDuration());
+        TEST_ASSERT_TRUE(isfinite(meter.getCurrentFlowrate()));
+    }
+
+    scheduler.setPeriod(0);
+    nativeSetMicros(11000);
+    TEST_ASSERT_EQUAL_UINT8(1, scheduler.poll());
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.getPeriod(0));
+
+    scheduler.setAdaptive(250, 10000, 0);                                   // no flow
+    nativeSetMicros(12000);
+    TEST_ASSERT_EQUAL_UINT8(1, scheduler.poll());
+    TEST_ASSERT_EQUAL_UINT32(10000, scheduler.getPeriod(0));
+
+    nativeSetMicros(10012000);                                             // 10 s after the previous tick
+    TEST_ASSERT_EQUAL_UINT8(1, scheduler.poll());
+    TEST_ASSERT_EQUAL_UINT32(10000, scheduler.getPeriod(0));
+    TEST_ASSERT_EQUAL_UINT32(10000, meter.getCurrentDuration());
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_fixed);
+    RUN_TEST(test_adaptive);
+    RUN_TEST(test_adaptive_trickle);
+    RUN_TEST(test_drift_free);
+    RUN_TEST(test_meter_types);
+    RUN_TEST(test_degenerate);
+    return UNITY_END();
+}
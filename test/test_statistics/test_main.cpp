@@ -0,0 +1,100 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Tests of the rolling statistics window fed by FlowMeter (run with: pio test -e native).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <algorithm>
+#include <random>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "FlowStatistics.h"
+#include "Injected.h"
+
+static const unsigned int ticks = 4096;
+
+/**
+ * Feeds bursty flow (the valve open for one tick in ten) through a meter, and checks the window against a recomputation over the last ticks.
+ */
+template <uint8_t Window>
+static void window() {
+    static FlowStatistics<Window> statistics;
+    static unsigned long pulses[ticks];
+    std::minstd_rand random(42);
+    std::bernoulli_distribution open(0.1);
+    std::uniform_int_distribution<unsigned long> flow(50, 100);
+    Injected<FlowMeter> meter(2, UncalibratedSensor);
+    double smoothed = 0.0;
+
+    statistics.clear();
+    meter.setStatistics(&statistics);
+
+    TEST_ASSERT_EQUAL_UINT8(Window, statistics.getWindow());
+    TEST_ASSERT_EQUAL_UINT8(0, statistics.getCount());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 0.0, statistics.getAverage());
+
+    for (unsigned int i = 0; i < ticks; i++) {
+        pulses[i] = open(random) ? flow(random) : 0;
+        meter.inject(pulses[i]);
+        meter.update(1000);
+
+        unsigned int first = i + 1 > Window ? i + 1 - Window : 0;          // oldest tick in the window
+        double expected[3] = {0.0, 1e300, -1e300};                          // average, minimum, maximum (in l/min)
+
+        for (unsigned int j = first; j <= i; j++) {
+            double flowrate = pulses[j] / UncalibratedSensor.kFactor;       // 1000 ms ticks: the frequency equals the pulses of the tick
+
+            expected[0] += flowrate / (i + 1 - first);
+            expected[1] = std::min(expected[1], flowrate);
+            expected[2] = std::max(expected[2], flowrate);
+        }
+
+        double latest = pulses[i] / UncalibratedSensor.kFactor;
+        smoothed = i == 0 ? latest : smoothed + 2.0f / (Window + 1) * (latest - smoothed);   // (the window sets the weight in float)
+
+        TEST_ASSERT_EQUAL_UINT8(i + 1 - first, statistics.getCount());
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9 * (1.0 + expected[0]), expected[0], statistics.getAverage());
+        TEST_ASSERT_EQUAL_DOUBLE(expected[1], statistics.getMinimum());
+        TEST_ASSERT_EQUAL_DOUBLE(expected[2], statistics.getMaximum());
+        TEST_ASSERT_EQUAL_DOUBLE(latest, statistics.getLatest());
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9 * (1.0 + smoothed), smoothed, statistics.getSmoothed());
+    }
+
+    meter.setStatistics(NULL);
+}
+
+static void test_window_8(void) {
+    window<8>();
+}
+
+static void test_window_60(void) {
+    window<60>();
+}
+
+static void test_window_255(void) {
+    window<255>();
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_window_8);
+    RUN_TEST(test_window_60);
+    RUN_TEST(test_window_255);
+    return UNITY_END();
+}
@@ -0,0 +1,165 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Round trip tests of FlowTelemetry frames through FlowTelemetryDecoder (run with: pio test -e native).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <math.h>
+#include <random>
+#include <vector>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "FlowTelemetry.h"
+#include "FlowTelemetryDecoder.h"
+#include "Injected.h"
+
+static const unsigned long frames = 86400 / 16;                             // a day of one second ticks, every 16th sent
+
+/**
+ * Records a day of bursty readings (idle, or up to 100 pulses per tick) of the given number of meters, one row of readings per frame.
+ */
+static void record(uint8_t meters, std::vector<FlowTelemetryDecoder::Reading> &truth) {
+    std::minstd_rand random(42);
+    std::bernoulli_distribution flowing(0.3);
+    std::uniform_int_distribution<unsigned long> flow(0, 100);
+
+    truth.assign(frames * meters, FlowTelemetryDecoder::Reading());
+
+    for (uint8_t meter = 0; meter < meters; meter++) {
+        Injected<FlowMeter> flowMeter(2, UncalibratedSensor);
+
+        for (unsigned long tick = 0; tick < frames * 16; tick++) {
+            flowMeter.inject(flowing(random) ? flow(random) : 0);
+            flowMeter.update(1000);
+
+            if (tick % 16 == 15) {
+                FlowTelemetryDecoder::Reading reading = {flowMeter.getTotalDuration64(), flowMeter.getTotalVolume(), flowMeter.getCurrentFlowrate(), true};
+                truth[tick / 16 * meters + meter] = reading;
+            }
+        }
+    }
+}
+
+/**
+ * Encodes the readings as frames, then sends them through a lossy link (every 50th frame dropped, a byte of every 97th flipped).
+ * Every frame that arrives intact has to be decoded, and every reading the decoder reports as known has to match the meter's
+ * within the resolution of the frame (1 ul, 1 ml/min).
+ */
+static void roundTrip(uint8_t meters) {
+    std::vector<FlowTelemetryDecoder::Reading> truth;
+    record(meters, truth);
+
+    FlowTelemetry<16> encoder;
+    std::vector<uint8_t> received;
+    std::vector<uint8_t> frame(FlowTelemetryBase::frameSize(meters));
+    unsigned long sent = 0;
+
+    for (unsigned long index = 0; index < frames; index++) {
+        TEST_ASSERT_TRUE(encoder.begin(frame.data(), frame.size()));
+
+        for (uint8_t meter = 0; meter < meters; meter++) {
+            const FlowTelemetryDecoder::Reading &reading = truth[index * meters + meter];
+            TEST_ASSERT_TRUE(encoder.add(reading.totalDuration, reading.totalVolume, reading.currentFlowrate));
+        }
+
+        size_t length = encoder.end();
+        TEST_ASSERT_GREATER_THAN(0, length);
+
+        if (index % 50 == 49) {
+            continue;                                                       // dropped
+        }
+
+        size_t start = received.size();
+        received.insert(received.end(), frame.begin(), frame.begin() + length);
+
+        if (index % 97 == 96) {
+            received[start + length / 2] ^= 0x10;                           // corrupted
+        } else {
+            sent++;
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(frames, encoder.getFrameCount());
+
+    FlowTelemetryDecoder decoder;
+    unsigned long decoded = 0, known = 0;
+    size_t position = 0, step;
+
+    while ((step = decoder.decode(received.data() + position, received.size() - position)) > 0) {
+        position += step;
+
+        if (decoder.getFrameCount() == decoded) {
+            continue;                                                       // skipped a corrupt frame
+        }
+
+        decoded = decoder.getFrameCount();
+        TEST_ASSERT_EQUAL_UINT32(meters, decoder.getMeterCount());
+
+        for (size_t meter = 0; meter < decoder.getMeterCount(); meter++) {
+            FlowTelemetryDecoder::Reading reading = decoder.getReading(meter);
+            const FlowTelemetryDecoder::Reading &expected = truth[decoder.getSequence() * meters + meter];
+
+            if (reading.known) {
+                known++;
+                TEST_ASSERT_EQUAL_UINT64(expected.totalDuration, reading.totalDuration);
+                TEST_ASSERT_DOUBLE_WITHIN(0.5e-6 + 1e-12 * expected.totalVolume, expected.totalVolume, reading.totalVolume);
+                TEST_ASSERT_DOUBLE_WITHIN(0.5e-3, expected.currentFlowrate, reading.currentFlowrate);
+            }
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(sent, decoder.getFrameCount());
+    TEST_ASSERT_GREATER_THAN(sent * meters * 3 / 4, known);                 // unknown only until the next keyframe after a loss
+    TEST_ASSERT_GREATER_THAN(0, decoder.getLostFrameCount());
+    TEST_ASSERT_GREATER_THAN(0, decoder.getSkippedByteCount());
+}
+
+static void test_one_meter(void) {
+    roundTrip(1);
+}
+
+static void test_two_meters(void) {
+    roundTrip(2);
+}
+
+static void test_sixteen_meters(void) {
+    roundTrip(16);
+}
+
+/**
+ * A frame that doesn't fit the buffer is refused as a whole.
+ */
+static void test_buffer_too_small(void) {
+    FlowTelemetry<2> encoder;
+    uint8_t frame[FlowTelemetryBase::frameSize(2)];
+
+    TEST_ASSERT_FALSE(encoder.begin(frame, 4));
+    TEST_ASSERT_TRUE(encoder.begin(frame, 8));
+    encoder.add(86400000ULL, 12345.678, 25.0);
+    TEST_ASSERT_EQUAL_UINT32(0, encoder.end());
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_one_meter);
+    RUN_TEST(test_two_meters);
+    RUN_TEST(test_sixteen_meters);
+    RUN_TEST(test_buffer_too_small);
+    return UNITY_END();
+}
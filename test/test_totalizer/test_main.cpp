@@ -0,0 +1,186 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Tests of FlowTotalizer on a memory-mapped file, across simulated power cycles (run with: pio test -e native).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <math.h>
+#include <random>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "FlowTotalizer.h"
+#include "FlowFileStorage.h"
+#include "Injected.h"
+
+static char path[] = "/tmp/flowtotalizerXXXXXX";
+
+/**
+ * Runs a meter on FS400A_cal up to its capacity for the given number of one second ticks, with a throttled totalizer.
+ */
+static void run(Injected<FlowMeter> &meter, FlowTotalizer &totalizer, unsigned long ticks) {
+    std::minstd_rand random(42);
+    std::uniform_int_distribution<unsigned long> flow(0, (unsigned long) (FS400A_cal.capacity * FS400A_cal.kFactor));
+
+    for (unsigned long i = 0; i < ticks; i++) {
+        meter.inject(flow(random));
+        meter.update(1000);
+        totalizer.update(meter);
+    }
+}
+
+static void test_empty(void) {
+    FlowFileStorage storage(path, 1024);
+    FlowTotalizer totalizer(storage);
+    FlowSnapshot snapshot;
+
+    TEST_ASSERT_TRUE(storage.isOpen());
+    TEST_ASSERT_EQUAL_UINT(1024 / FlowTotalizer::recordSize, totalizer.getSlotCount());
+    TEST_ASSERT_FALSE(totalizer.load(snapshot));                            // erased memory holds no snapshot
+}
+
+/**
+ * The totals come back after a clean power cycle, i.e. from a fresh mapping of the file.
+ */
+static void test_power_cycle(void) {
+    Injected<FlowMeter> meter(2, FS400A_cal);
+
+    {
+        FlowFileStorage storage(path, 1024);
+        FlowTotalizer totalizer(storage);
+
+        totalizer.setThrottle(1.0, 3600000);
+        run(meter, totalizer, 86400);
+        totalizer.snapshot(meter);                                          // e.g. on a brown-out warning
+    }
+
+    FlowFileStorage storage(path, 1024);
+    FlowTotalizer rebooted(storage);
+    Injected<FlowMeter> restored(2, FS400A_cal);
+
+    TEST_ASSERT_TRUE(rebooted.restore(restored));
+    TEST_ASSERT_EQUAL_UINT64(meter.getTotalDuration64(), restored.getTotalDuration64());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, meter.getTotalVolume(), restored.getTotalVolume());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-4, meter.getTotalError(), restored.getTotalError());
+}
+
+/**
+ * A power cut half way through a record loses only that record.
+ */
+static void test_torn_record(void) {
+    FlowFileStorage storage(path, 1024);
+    FlowTotalizer totalizer(storage);
+    Injected<FlowMeter> meter(2, FS400A_cal);
+
+    totalizer.setThrottle(1.0, 3600000);
+    run(meter, totalizer, 3 * 3600);
+    totalizer.snapshot(meter);
+
+    uint32_t sequence = totalizer.getSequence();
+    uint8_t torn[FlowTotalizer::recordSize / 2] = {FlowTotalizer::version};
+    unsigned int slot = (sequence + 1) % totalizer.getSlotCount();          // sequence numbers start at slot 0
+
+    storage.write(slot * FlowTotalizer::recordSize, torn, sizeof(torn));
+
+    FlowTotalizer rebooted(storage);
+    FlowSnapshot snapshot;
+
+    TEST_ASSERT_TRUE(rebooted.load(snapshot));
+    TEST_ASSERT_EQUAL_UINT32(sequence, rebooted.getSequence());
+    TEST_ASSERT_EQUAL_UINT64(meter.getTotalDuration64(), snapshot.totalDuration);
+}
+
+/**
+ * The throttle limits the writes, erase() invalidates them.
+ */
+static void test_throttle(void) {
+    FlowFileStorage storage(path, 1024);
+    FlowTotalizer totalizer(storage);
+    Injected<FlowMeter> meter(2, FS400A_cal);
+    const unsigned long days = 30;
+
+    totalizer.setThrottle(0.0, 86400000);                                   // once a day
+    run(meter, totalizer, days * 86400);
+
+    TEST_ASSERT_EQUAL_UINT(days, totalizer.getWriteCount());                // the first update() and one per following day
+
+    totalizer.erase();
+
+    FlowSnapshot snapshot;
+
+    TEST_ASSERT_FALSE(totalizer.load(snapshot));
+}
+
+/**
+ * A meter that is updated (and totalized) before it has been restored, or one that was reset, doesn't bury the saved totals.
+ */
+static void test_update_before_restore(void) {
+    Injected<FlowMeter> meter(2, FS400A_cal);
+
+    {
+        FlowFileStorage storage(path, 1024);
+        FlowTotalizer totalizer(storage);
+
+        totalizer.setThrottle(1.0, 3600000);
+        run(meter, totalizer, 86400);
+        totalizer.snapshot(meter);
+    }
+
+    FlowFileStorage storage(path, 1024);
+    FlowTotalizer rebooted(storage);
+    Injected<FlowMeter> early(2, FS400A_cal);
+    uint32_t sequence;
+
+    rebooted.setThrottle(1.0, 1000);
+    early.inject(100);
+    early.update(1000);
+    TEST_ASSERT_FALSE(rebooted.update(early));                             // fresh, small totals
+    sequence = rebooted.getSequence();
+
+    TEST_ASSERT_TRUE(rebooted.restore(early));                              // restored late: the saved totals replace the early ones
+    TEST_ASSERT_EQUAL_UINT64(meter.getTotalDuration64(), early.getTotalDuration64());
+
+    early.inject(100);
+    early.update(1000);
+    TEST_ASSERT_TRUE(rebooted.update(early));
+    TEST_ASSERT_EQUAL_UINT32(sequence + 1, rebooted.getSequence());
+
+    FlowSnapshot snapshot;
+
+    TEST_ASSERT_TRUE(rebooted.load(snapshot));
+    TEST_ASSERT_EQUAL_UINT64(meter.getTotalDuration64() + 1000, snapshot.totalDuration);
+}
+
+void setUp(void) {
+    int file = mkstemp(path);
+
+    close(file);
+    unlink(path);                                                           // start from erased memory
+}
+
+void tearDown(void) {
+    unlink(path);
+    strcpy(path, "/tmp/flowtotalizerXXXXXX");
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_empty);
+    RUN_TEST(test_power_cycle);
+    RUN_TEST(test_torn_record);
+    RUN_TEST(test_throttle);
+    RUN_TEST(test_update_before_restore);
+    return UNITY_END();
+}
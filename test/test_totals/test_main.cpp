@@ -0,0 +1,147 @@
+/**
+ * Flow Meter
+ *
+ * An Arduino flow meter library that provides calibrated liquid flow and volume measurement with flow sensors.
+ *
+ * Tests of the long-horizon totals, i.e. 64-bit durations and the total volume derived from pulse counts (run with: pio test -e native).
+ *
+ * @author sekdiy (https://github.com/sekdiy/FlowMeter)
+ * @date 18.10.2026 Initial release.
+ * @version See git comments for changes.
+ */
+
+#include <math.h>
+#include <random>
+#include <unity.h>
+#include "Arduino.h"
+#include "FlowMeter.h"
+#include "CaptureFlowMeter.h"
+#include "StaticFlowMeter.h"
+#include "Injected.h"
+
+static const unsigned long days = 100;
+
+/**
+ * Runs a meter for months of one second ticks, and compares its totals against an exact (long double) sum of the ticks.
+ */
+template <class Meter, class Distribution>
+static void horizon(Meter &meter, Distribution distribution) {
+    std::minstd_rand random(42);
+    long double exact = 0.0L;                                               // exact total volume (in l)
+    uint64_t pulses = 0;
+
+    for (unsigned long tick = 0; tick < days * 86400; tick++) {
+        unsigned long current = distribution(random);
+
+        meter.inject(current);
+        meter.update(1000);
+        exact += meter.getCurrentVolume();
+        pulses += current;
+    }
+
+    TEST_ASSERT_EQUAL_UINT64(days * 86400000ULL, meter.getTotalDuration64());
+    TEST_ASSERT_EQUAL_UINT64(pulses, meter.getTotalPulses());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12 * (double) exact, (double) exact, meter.getTotalVolume());
+}
+
+static void test_trickle(void) {
+    Injected<FlowMeter> meter(2, FS400A_cal);
+    std::poisson_distribution<unsigned long> flow(0.02 * FS400A_cal.capacity * FS400A_cal.kFactor);
+
+    horizon(meter, [&](std::minstd_rand &random) { return flow(random); });
+}
+
+static void test_uniform(void) {
+    Injected<FlowMeter> meter(2, FS400A_cal);
+    std::uniform_int_distribution<unsigned long> flow(0, (unsigned long) (FS400A_cal.capacity * FS400A_cal.kFactor));
+
+    horizon(meter, [&](std::minstd_rand &random) { return flow(random); });
+}
+
+static void test_curve(void) {
+    FlowCalibrationCurve curve(FS400A_cal);
+    Injected<FlowMeter> meter(2, FS400A_cal, curve);
+    std::uniform_int_distribution<unsigned long> flow(0, (unsigned long) (FS400A_cal.capacity * FS400A_cal.kFactor));
+
+    horizon(meter, [&](std::minstd_rand &random) { return flow(random); });
+}
+
+static void test_static(void) {
+    Injected<StaticFlowMeter<FS400A_calTraits>> meter(2);
+    std::uniform_int_distribution<unsigned long> flow(0, (unsigned long) (FS400A_cal.capacity * FS400A_cal.kFactor));
+
+    horizon(meter, [&](std::minstd_rand &random) { return flow(random); });
+}
+
+/**
+ * The capturing meter picks its decile from the period-based pulse rate, and its totals follow that.
+ */
+static void test_capture(void) {
+    nativeSetMicros(0);
+    FlowMeter counting(2, FS400A_cal);
+    CaptureFlowMeter capturing(2, FS400A_cal);
+    long double exact = 0.0L;
+
+    for (unsigned long tick = 1; tick <= 600; tick++) {
+        unsigned long pulses = tick % 60;
+
+        for (unsigned long i = 1; i <= pulses; i++) {
+            nativeSetMicros((tick - 1) * 1000000UL + i * 1000000UL / (pulses + 1));
+            counting.count();
+            capturing.count();
+        }
+
+        nativeSetMicros(tick * 1000000UL);
+        counting.update(1000);
+        capturing.update(1000);
+        exact += capturing.getCurrentVolume();
+    }
+
+    TEST_ASSERT_EQUAL_UINT64(counting.getTotalPulses(), capturing.getTotalPulses());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12 * (double) exact, (double) exact, capturing.getTotalVolume());
+}
+
+/**
+ * Setting the total volume (e.g. after a power cycle) restarts the pulse counts, and further ticks add to it.
+ */
+static void test_set_total_volume(void) {
+    Injected<FlowMeter> meter(2, FS400A_cal);
+
+    meter.inject(100);
+    meter.update(1000);
+    meter.setTotalVolume(1234.5);
+
+    TEST_ASSERT_EQUAL_UINT64(0, meter.getTotalPulses());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 1234.5, meter.getTotalVolume());
+
+    meter.inject(100);
+    meter.update(1000);
+
+    TEST_ASSERT_EQUAL_UINT64(100, meter.getTotalPulses());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 1234.5 + meter.getCurrentVolume(), meter.getTotalVolume());
+
+    double total = meter.getTotalVolume();
+    meter.setProperties(FS400A);                                            // keeps the total volume
+
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, total, meter.getTotalVolume());
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_trickle);
+    RUN_TEST(test_uniform);
+    RUN_TEST(test_curve);
+    RUN_TEST(test_static);
+    RUN_TEST(test_capture);
+    RUN_TEST(test_set_total_volume);
+    return UNITY_END();
+}